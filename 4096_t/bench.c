@@ -0,0 +1,336 @@
+/* bench.c - native 4096_t against the GMP backend, per operation */
+
+/*
+ * gcc -O2 bench.c 4096_t.c -o bench -lgmp
+ *
+ * Every op is first checked against GMP computed directly on random
+ * inputs, and only backends that agree are timed. modexp, gcd and the
+ * modular inverse are built from the backend's own add/sub/mul/quo/rem,
+ * the way bigrsa and bigkey use them, so they need those to be correct.
+ * Values live in 4096 bit (S limb) containers, so an op is reported as
+ * n/a at a size whose intermediates would not fit.
+ */
+
+#include <gmp.h>
+#include <time.h>
+#include "4096_t.h"
+
+#define TRIALS 32    /* random inputs for the differential check */
+#define POOL 16      /* input sets cycled through while timing */
+#define MIN_NS 100000000ULL
+
+typedef uint64_t (*bigop)(uint64_t *, uint64_t *, uint64_t *);
+
+typedef struct backend {
+    const char *name;
+    bigop add, sub, mul, quo, rem;
+} backend;
+
+enum { ADD, SUB, MUL, SQR, DIV, MODEXP, GCD, INV, OPS };
+
+static const char *op_names[OPS] = {
+    "add", "sub", "mul", "sqr", "div", "modexp", "gcd", "inverse"
+};
+
+/* which primitives an op is built from */
+static const unsigned op_needs[OPS] = {
+    1 << ADD, 1 << SUB, 1 << MUL, 1 << MUL, 1 << DIV,
+    1 << MUL | 1 << DIV,
+    1 << DIV,
+    1 << ADD | 1 << SUB | 1 << MUL | 1 << DIV
+};
+
+/* biggmp style wrappers, import and export on every call */
+
+static void lambda(uint64_t *a, uint64_t *b, uint64_t *c, void (f)(mpz_t, const mpz_t, const mpz_t)) {
+    mpz_t m0, m1;
+    memset(c, 0, BYTES);
+    mpz_inits(m0, m1, NULL);
+    mpz_import(m0, S, -1, sizeof(uint64_t), 0, 0, a);
+    mpz_import(m1, S, -1, sizeof(uint64_t), 0, 0, b);
+    f(m0, m0, m1);
+    mpz_export(c, NULL, -1, sizeof(uint64_t), 0, 0, m0);
+    mpz_clears(m0, m1, NULL);
+}
+
+static uint64_t gmp_add(uint64_t *a, uint64_t *b, uint64_t *c) { lambda(a, b, c, mpz_add); return 0; }
+static uint64_t gmp_sub(uint64_t *a, uint64_t *b, uint64_t *c) { lambda(a, b, c, mpz_sub); return 0; }
+static uint64_t gmp_mul(uint64_t *a, uint64_t *b, uint64_t *c) { lambda(a, b, c, mpz_mul); return 0; }
+static uint64_t gmp_quo(uint64_t *a, uint64_t *b, uint64_t *c) { lambda(a, b, c, mpz_tdiv_q); return 0; }
+static uint64_t gmp_rem(uint64_t *a, uint64_t *b, uint64_t *c) { lambda(a, b, c, mpz_tdiv_r); return 0; }
+
+static const backend backends[2] = {
+    { "native", bigadd, bigsub, bigmul, bigquo, bigrem },
+    { "gmp", gmp_add, gmp_sub, gmp_mul, gmp_quo, gmp_rem }
+};
+
+/* helpers on S limb values */
+
+static uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rnd(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+/* random value of exactly bits bits */
+static void big_rand(uint64_t *a, size_t bits) {
+    size_t i;
+    memset(a, 0, BYTES);
+    for (i = 0; i < (bits + 63) / 64; i++) {
+        a[i] = rnd();
+    }
+    if (bits % 64) {
+        a[i - 1] &= (1ULL << (bits % 64)) - 1;
+    }
+    a[(bits - 1) / 64] |= 1ULL << ((bits - 1) % 64);
+}
+
+static int big_zero(uint64_t *a) {
+    size_t i;
+    for (i = 0; i < S && !a[i]; i++) { }
+    return i == S;
+}
+
+static int big_ge(uint64_t *a, uint64_t *b) {
+    size_t i;
+    for (i = S - 1; i > 0 && a[i] == b[i]; i--) { }
+    return a[i] >= b[i];
+}
+
+static int big_bit(uint64_t *a, size_t i) {
+    return (int)(a[i / 64] >> (i % 64) & 1);
+}
+
+/* ops composed from a backend */
+
+static void b_modexp(const backend *be, uint64_t *x, uint64_t *e, uint64_t *m, uint64_t *r, size_t bits) {
+    uint64_t t[2 * S];
+    size_t i;
+    memset(r, 0, BYTES);
+    r[0] = 1;
+    for (i = bits; i-- > 0;) {
+        be->mul(r, r, t);
+        be->rem(t, m, r);
+        if (big_bit(e, i)) {
+            be->mul(r, x, t);
+            be->rem(t, m, r);
+        }
+    }
+}
+
+static void b_gcd(const backend *be, uint64_t *a, uint64_t *b, uint64_t *r) {
+    uint64_t x[2 * S], y[2 * S], t[2 * S];
+    memcpy(x, a, BYTES);
+    memcpy(y, b, BYTES);
+    while (!big_zero(y)) {
+        be->rem(x, y, t);
+        memcpy(x, y, BYTES);
+        memcpy(y, t, BYTES);
+    }
+    memcpy(r, x, BYTES);
+}
+
+/* a^-1 mod m for gcd(a, m) = 1, coefficients kept reduced mod m */
+static void b_inv(const backend *be, uint64_t *a, uint64_t *m, uint64_t *r) {
+    uint64_t r0[2 * S], r1[2 * S], t0[2 * S], t1[2 * S], q[2 * S], p[2 * S], u[2 * S];
+    memcpy(r0, m, BYTES);
+    memcpy(r1, a, BYTES);
+    memset(t0, 0, BYTES);
+    memset(t1, 0, BYTES);
+    t1[0] = 1;
+    while (!big_zero(r1)) {
+        be->quo(r0, r1, q);
+        be->mul(q, r1, p);
+        be->sub(r0, p, u);
+        memcpy(r0, r1, BYTES);
+        memcpy(r1, u, BYTES);
+        /* t0 - q * t1 mod m */
+        be->mul(q, t1, p);
+        be->rem(p, m, u);
+        if (big_ge(t0, u)) {
+            be->sub(t0, u, p);
+        } else {
+            be->add(t0, m, q);
+            be->sub(q, u, p);
+        }
+        memcpy(t0, t1, BYTES);
+        memcpy(t1, p, BYTES);
+    }
+    memcpy(r, t0, BYTES);
+}
+
+/* one set of operands per op and size */
+
+typedef struct inputs {
+    uint64_t a[2 * S], b[2 * S], m[2 * S];
+} inputs;
+
+static void make_inputs(int op, size_t bits, inputs *in) {
+    mpz_t x, y;
+    memset(in, 0, sizeof(*in));
+    switch (op) {
+    case ADD:
+    case SUB:
+        big_rand(in->a, bits - 1);
+        big_rand(in->b, bits - 2);
+        break;
+    case MUL:
+    case SQR:
+        big_rand(in->a, bits);
+        big_rand(in->b, bits);
+        break;
+    case DIV:
+        big_rand(in->a, bits);
+        big_rand(in->b, bits / 2);
+        break;
+    case MODEXP:
+        big_rand(in->m, bits);
+        in->m[0] |= 1;
+        big_rand(in->a, bits - 1);
+        big_rand(in->b, bits);
+        break;
+    case GCD:
+        big_rand(in->a, bits);
+        big_rand(in->b, bits - 1);
+        break;
+    case INV:
+        mpz_inits(x, y, NULL);
+        do {
+            big_rand(in->m, bits);
+            big_rand(in->a, bits - 1);
+            mpz_import(x, S, -1, sizeof(uint64_t), 0, 0, in->a);
+            mpz_import(y, S, -1, sizeof(uint64_t), 0, 0, in->m);
+            mpz_gcd(x, x, y);
+        } while (mpz_cmp_ui(x, 1));
+        mpz_clears(x, y, NULL);
+        break;
+    }
+}
+
+/* does the op fit a 4096 bit container at this size */
+static int fits(int op, size_t bits) {
+    return !(op == MUL || op == SQR || op == MODEXP || op == INV) || 2 * bits <= S * 64;
+}
+
+static void run(const backend *be, int op, size_t bits, inputs *in, uint64_t *out) {
+    switch (op) {
+    case ADD: be->add(in->a, in->b, out); break;
+    case SUB: be->sub(in->a, in->b, out); break;
+    case MUL: be->mul(in->a, in->b, out); break;
+    case SQR: be->mul(in->a, in->a, out); break;
+    case DIV: be->quo(in->a, in->b, out); be->rem(in->a, in->b, out + S); break;
+    case MODEXP: b_modexp(be, in->a, in->b, in->m, out, bits); break;
+    case GCD: b_gcd(be, in->a, in->b, out); break;
+    case INV: b_inv(be, in->a, in->m, out); break;
+    }
+}
+
+/* the same op straight from GMP */
+static void reference(int op, inputs *in, uint64_t *out) {
+    mpz_t a, b, m, r, s;
+    mpz_inits(a, b, m, r, s, NULL);
+    mpz_import(a, S, -1, sizeof(uint64_t), 0, 0, in->a);
+    mpz_import(b, S, -1, sizeof(uint64_t), 0, 0, in->b);
+    mpz_import(m, S, -1, sizeof(uint64_t), 0, 0, in->m);
+    switch (op) {
+    case ADD: mpz_add(r, a, b); break;
+    case SUB: mpz_sub(r, a, b); break;
+    case MUL: mpz_mul(r, a, b); break;
+    case SQR: mpz_mul(r, a, a); break;
+    case DIV: mpz_tdiv_qr(r, s, a, b); break;
+    case MODEXP: mpz_powm(r, a, b, m); break;
+    case GCD: mpz_gcd(r, a, b); break;
+    case INV: mpz_invert(r, a, m); break;
+    }
+    memset(out, 0, 2 * BYTES);
+    mpz_export(out, NULL, -1, sizeof(uint64_t), 0, 0, r);
+    if (op == DIV) {
+        mpz_export(out + S, NULL, -1, sizeof(uint64_t), 0, 0, s);
+    }
+    mpz_clears(a, b, m, r, s, NULL);
+}
+
+/* differential check on TRIALS random inputs */
+static int check(const backend *be, int op, size_t bits) {
+    static inputs in;
+    uint64_t got[2 * S], want[2 * S];
+    size_t width = op == DIV ? 2 * S : S;
+    int i;
+    for (i = 0; i < TRIALS; i++) {
+        make_inputs(op, bits, &in);
+        memset(got, 0, sizeof(got));
+        run(be, op, bits, &in, got);
+        reference(op, &in, want);
+        if (memcmp(got, want, width * sizeof(uint64_t))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ns per op, repeating over the input pool for at least MIN_NS */
+static double timed(const backend *be, int op, size_t bits, inputs *pool) {
+    uint64_t out[2 * S], start = now_ns(), elapsed, n = 0;
+    do {
+        run(be, op, bits, &pool[n % POOL], out);
+        n++;
+        elapsed = now_ns() - start;
+    } while (elapsed < MIN_NS || n < POOL);
+    return (double)elapsed / (double)n;
+}
+
+int main(void) {
+    static const size_t sizes[3] = { 1024, 2048, 4096 };
+    static inputs pool[POOL];
+    double ns[2];
+    int ok[2][OPS], op, k, j;
+    size_t s, i;
+
+    printf("%5s %-8s %14s %14s %10s  %s\n", "bits", "op", "native ns/op", "gmp ns/op", "gmp/native", "check");
+    for (s = 0; s < 3; s++) {
+        size_t bits = sizes[s];
+        for (op = 0; op < OPS; op++) {
+            if (!fits(op, bits)) {
+                ok[0][op] = ok[1][op] = 0;
+                printf("%5lu %-8s %14s %14s %10s  %s\n", bits, op_names[op], "-", "-", "-", "n/a, exceeds 4096 bits");
+                continue;
+            }
+            for (i = 0; i < POOL; i++) {
+                make_inputs(op, bits, &pool[i]);
+            }
+            for (k = 0; k < 2; k++) {
+                ok[k][op] = 1;
+                for (j = 0; j < op; j++) {
+                    if ((op_needs[op] >> j & 1) && !ok[k][j]) {
+                        ok[k][op] = 0;
+                    }
+                }
+                ok[k][op] = ok[k][op] && check(&backends[k], op, bits);
+                ns[k] = ok[k][op] ? timed(&backends[k], op, bits, pool) : 0;
+            }
+            printf("%5lu %-8s ", bits, op_names[op]);
+            for (k = 0; k < 2; k++) {
+                if (ok[k][op]) {
+                    printf("%14.0f ", ns[k]);
+                } else {
+                    printf("%14s ", "FAIL");
+                }
+            }
+            if (ok[0][op] && ok[1][op]) {
+                printf("%9.2fx  ok\n", ns[1] / ns[0]);
+            } else {
+                printf("%10s  %s\n", "-", ok[0][op] ? "gmp backend mismatch" : "native mismatch or unimplemented");
+            }
+        }
+    }
+    return 0;
+}
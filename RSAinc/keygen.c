@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <stdint.h>
+#include "rsakey.h"
 
 unsigned long generate_prime() {
     unsigned long primes[] = {10007, 10009, 10037, 10039, 10061};
@@ -29,6 +31,7 @@ unsigned long mod_inverse(unsigned long e, unsigned long phi) {
 
 int main() {
     unsigned long p, q, n, phi, e, d;
+    uint64_t bn, be, bd;
     FILE *bad;
     FILE *pub;
 
@@ -58,5 +61,12 @@ int main() {
     fprintf(pub, "-----END UNSAFE PUBLIC KEY-----\n");
     fclose(pub);
 
+    /* binary copies with the montgomery constants rsainc would otherwise derive */
+    bn = n;
+    be = e;
+    bd = d;
+    if (rsakey_write(RSAKEY_BAD, &bn, &be, &bd, 1)) return 1;
+    if (rsakey_write(RSAKEY_PUB, &bn, &be, NULL, 1)) return 1;
+
     return 0;
 }
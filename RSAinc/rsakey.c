@@ -0,0 +1,178 @@
+/* rsakey.c - binary, mmap-able key files with cached montgomery constants */
+
+#include "rsakey.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "rsakey maps limbs in place and needs a little-endian host"
+#endif
+
+#define FNV_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+static size_t file_len(size_t words) {
+    return sizeof(rsakey_hdr) + 5 * words * sizeof(uint64_t);
+}
+
+static uint64_t fnv(uint64_t h, const void *p, size_t len) {
+    const uint8_t *b = p;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ b[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+// Checksum of a whole file image, skipping the sum field itself
+static uint64_t checksum(const uint8_t *file, size_t len) {
+    uint64_t h = fnv(FNV_BASIS, file, offsetof(rsakey_hdr, sum));
+    return fnv(h, file + sizeof(rsakey_hdr), len - sizeof(rsakey_hdr));
+}
+
+uint64_t mont_n0inv(uint64_t n0) {
+    uint64_t x = n0; // good to 3 bits, each step doubles that
+    for (int i = 0; i < 5; i++) {
+        x *= 2 - n0 * x;
+    }
+    return -x;
+}
+
+// r = 2r mod n, for r < n
+static void dbl_mod(uint64_t *r, const uint64_t *n, size_t words) {
+    uint64_t carry = 0, borrow = 0;
+    size_t i;
+    for (i = 0; i < words; i++) {
+        uint64_t top = r[i] >> 63;
+        r[i] = (r[i] << 1) | carry;
+        carry = top;
+    }
+    if (!carry) {
+        for (i = words; i > 0 && r[i - 1] == n[i - 1]; i--) { }
+        if (i > 0 && r[i - 1] < n[i - 1]) {
+            return;
+        }
+    }
+    for (i = 0; i < words; i++) {
+        uint64_t d = r[i] - n[i] - borrow;
+        borrow = r[i] < n[i] || (r[i] == n[i] && borrow);
+        r[i] = d;
+    }
+}
+
+void rsakey_setup(rsakey_t *key, uint64_t *limbs, size_t words) {
+    uint64_t *n = limbs, *r2 = limbs + 3 * words, *r1 = limbs + 4 * words;
+    size_t i;
+
+    // 1 doubled 64w times is R mod n, another 64w times gives R^2 mod n
+    memset(r1, 0, words * sizeof(uint64_t));
+    r1[0] = 1;
+    for (i = 0; i < 64 * words; i++) {
+        dbl_mod(r1, n, words);
+    }
+    memcpy(r2, r1, words * sizeof(uint64_t));
+    for (i = 0; i < 64 * words; i++) {
+        dbl_mod(r2, n, words);
+    }
+
+    key->words = words;
+    key->n0inv = mont_n0inv(n[0]);
+    key->n = n;
+    key->e = limbs + words;
+    key->d = limbs + 2 * words;
+    key->r2 = r2;
+    key->r1 = r1;
+    key->map = NULL;
+    key->maplen = 0;
+}
+
+int rsakey_write(const char *path, const uint64_t *n, const uint64_t *e,
+                 const uint64_t *d, size_t words) {
+    size_t len = file_len(words);
+    uint8_t *file = calloc(1, len);
+    rsakey_hdr *hdr = (rsakey_hdr *)file;
+    uint64_t *limbs = (uint64_t *)(file + sizeof(rsakey_hdr));
+    rsakey_t key;
+    FILE *fp;
+    int ret = -1;
+
+    if (!file) {
+        return -1;
+    }
+    memcpy(limbs, n, words * sizeof(uint64_t));
+    memcpy(limbs + words, e, words * sizeof(uint64_t));
+    if (d) {
+        memcpy(limbs + 2 * words, d, words * sizeof(uint64_t));
+    }
+    rsakey_setup(&key, limbs, words);
+
+    memcpy(hdr->magic, RSAKEY_MAGIC, sizeof(hdr->magic));
+    hdr->words = (uint32_t)words;
+    hdr->priv = d != NULL;
+    hdr->n0inv = key.n0inv;
+    hdr->sum = checksum(file, len);
+
+    fp = fopen(path, "wb");
+    if (fp) {
+        ret = fwrite(file, 1, len, fp) == len ? 0 : -1;
+        if (fclose(fp)) {
+            ret = -1;
+        }
+    }
+    free(file);
+    return ret;
+}
+
+int rsakey_map(const char *path, rsakey_t *key) {
+    struct stat st;
+    const rsakey_hdr *hdr;
+    const uint64_t *limbs;
+    void *map;
+    size_t words;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) || (size_t)st.st_size < sizeof(rsakey_hdr)) {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    hdr = map;
+    words = hdr->words;
+    if (memcmp(hdr->magic, RSAKEY_MAGIC, sizeof(hdr->magic)) || !words
+        || (size_t)st.st_size != file_len(words)
+        || hdr->sum != checksum(map, (size_t)st.st_size)) {
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    limbs = (const uint64_t *)(hdr + 1);
+    key->words = words;
+    key->n0inv = hdr->n0inv;
+    key->n = limbs;
+    key->e = limbs + words;
+    key->d = hdr->priv ? limbs + 2 * words : NULL;
+    key->r2 = limbs + 3 * words;
+    key->r1 = limbs + 4 * words;
+    key->map = map;
+    key->maplen = (size_t)st.st_size;
+    return 0;
+}
+
+void rsakey_unmap(rsakey_t *key) {
+    if (key->map) {
+        munmap(key->map, key->maplen);
+        key->map = NULL;
+    }
+}
@@ -0,0 +1,62 @@
+/* rsakey.h */
+
+/*
+ Binary key files (unsafe.pub.bin / unsafe.bad.bin), written next to the
+ text keys by keygen and mapped straight into memory by rsainc.
+
+ Layout, all little-endian, w = words (64-bit limbs per number):
+   0        header (rsakey_hdr, 32 bytes)
+   32       n           w limbs
+   32 +  8w e           w limbs
+   32 + 16w d           w limbs, zero in a public key
+   32 + 24w R^2 mod n   w limbs, R = 2^(64w)
+   32 + 32w R mod n     w limbs, montgomery one
+ The checksum is FNV-1a 64 over every byte of the file except itself.
+ */
+
+#ifndef RSAKEY_H
+#define RSAKEY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RSAKEY_MAGIC "RSAKEYB1"
+#define RSAKEY_PUB "unsafe.pub.bin"
+#define RSAKEY_BAD "unsafe.bad.bin"
+
+typedef struct rsakey_hdr_struct {
+    char magic[8];   // RSAKEY_MAGIC, no terminator
+    uint32_t words;  // limbs per number
+    uint32_t priv;   // 1 if d is present
+    uint64_t n0inv;  // -n^-1 mod 2^64
+    uint64_t sum;    // checksum of the rest of the file
+} rsakey_hdr;
+
+typedef struct rsakey_struct {
+    size_t words;
+    uint64_t n0inv;
+    const uint64_t *n, *e, *d; // d is NULL for a public key
+    const uint64_t *r2, *r1;
+    void *map;                 // mapping backing the limbs, if any
+    size_t maplen;
+} rsakey_t;
+
+// -n0^-1 mod 2^64 for odd n0
+uint64_t mont_n0inv(uint64_t n0);
+
+// Fill R mod n and R^2 mod n in limbs (n, e, d, r2, r1 in 5 * words limbs)
+// and point key at them; n must be odd
+void rsakey_setup(rsakey_t *key, uint64_t *limbs, size_t words);
+
+// Write a binary key file, d may be NULL; returns 0 on success
+int rsakey_write(const char *path, const uint64_t *n, const uint64_t *e,
+                 const uint64_t *d, size_t words);
+
+// Map and verify a binary key file; returns 0 on success, -1 if it is
+// missing, truncated or fails the checksum
+int rsakey_map(const char *path, rsakey_t *key);
+
+// Release a mapping made by rsakey_map (harmless after rsakey_setup)
+void rsakey_unmap(rsakey_t *key);
+
+#endif /* RSAKEY_H */
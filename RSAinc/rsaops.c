@@ -0,0 +1,221 @@
+/* rsaops.c - word sized montgomery RSA */
+
+#include "rsaops.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* independent exponentiations interleaved by the scalar batch paths */
+#define LANES 4
+
+/* below this the vector paths fit a * b + m * n in 64 bit lanes, R = 2^32 */
+#define SMALL_N (1ULL << 31)
+
+/* REDC of a * b; a may be any word as long as b < n, since a * b < nR */
+static inline uint64_t redc(uint64_t a, uint64_t b, uint64_t n, uint64_t n0inv) {
+    __uint128_t t = (__uint128_t)a * b;
+    uint64_t lo = (uint64_t)t, hi = (uint64_t)(t >> 64);
+    uint64_t mh = (uint64_t)(((__uint128_t)(lo * n0inv) * n) >> 64);
+    uint64_t r = hi + mh + (lo != 0);
+    /* r < 2n, the add only wraps when n is above 2^63 */
+    return (r < hi) | (r >= n) ? r - n : r;
+}
+
+uint64_t mont_mul(uint64_t a, uint64_t b, uint64_t n, uint64_t n0inv) {
+    return redc(a, b, n, n0inv);
+}
+
+uint64_t modexp(uint64_t base, uint64_t exp, const rsakey_t *key) {
+    uint64_t n = key->n[0], n0inv = key->n0inv;
+    uint64_t x = redc(base, key->r2[0], n, n0inv);
+    uint64_t result = key->r1[0];
+    while (exp > 0) {
+        if (exp & 1) {
+            result = redc(result, x, n, n0inv);
+        }
+        x = redc(x, x, n, n0inv);
+        exp >>= 1;
+    }
+    return redc(result, 1, n, n0inv);
+}
+
+uint64_t modexp_pub(uint64_t base, const rsakey_t *key) {
+    uint64_t n = key->n[0], n0inv = key->n0inv;
+    uint64_t x = redc(base, key->r2[0], n, n0inv);
+    uint64_t y = x;
+    for (int i = 0; i < 16; i++) {
+        y = redc(y, y, n, n0inv);
+    }
+    return redc(redc(y, x, n, n0inv), 1, n, n0inv);
+}
+
+/* exponent bits below the top one, the lockstep schedule for every lane */
+static int top_bit(uint64_t exp) {
+    return 63 - __builtin_clzll(exp);
+}
+
+/* scalar lanes, 64 bit montgomery, any odd modulus */
+static void batch_scalar(const uint64_t *in, uint64_t *out, size_t count, uint64_t exp, const rsakey_t *key) {
+    uint64_t n = key->n[0], n0inv = key->n0inv, r2 = key->r2[0];
+    uint64_t x[LANES], y[LANES];
+    size_t i = 0;
+    int j, b, top = top_bit(exp);
+
+    for (; i + LANES <= count; i += LANES) {
+        for (j = 0; j < LANES; j++) {
+            x[j] = y[j] = redc(in[i + j], r2, n, n0inv);
+        }
+        for (b = top - 1; b >= 0; b--) {
+            for (j = 0; j < LANES; j++) {
+                y[j] = redc(y[j], y[j], n, n0inv);
+            }
+            if (exp >> b & 1) {
+                for (j = 0; j < LANES; j++) {
+                    y[j] = redc(y[j], x[j], n, n0inv);
+                }
+            }
+        }
+        for (j = 0; j < LANES; j++) {
+            out[i + j] = redc(y[j], 1, n, n0inv);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = modexp(in[i], exp, key);
+    }
+}
+
+#if defined(__AVX512F__)
+
+#define VLANES 8
+typedef __m512i vec;
+#define vset(x) _mm512_set1_epi64((long long)(x))
+#define vload(p) _mm512_loadu_si512(p)
+#define vstore(p, v) _mm512_storeu_si512(p, v)
+
+/* 8 REDCs with R = 2^32 for n < 2^31, results below n */
+static inline vec redc_v(vec a, vec b, vec n, vec ninv) {
+    vec t = _mm512_mul_epu32(a, b);
+    vec m = _mm512_mul_epu32(t, ninv);
+    vec r = _mm512_srli_epi64(_mm512_add_epi64(t, _mm512_mul_epu32(m, n)), 32);
+    return _mm512_min_epu64(r, _mm512_sub_epi64(r, n));
+}
+
+#elif defined(__AVX2__)
+
+#define VLANES 4
+typedef __m256i vec;
+#define vset(x) _mm256_set1_epi64x((long long)(x))
+#define vload(p) _mm256_loadu_si256((const __m256i *)(p))
+#define vstore(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+
+/* 4 REDCs with R = 2^32 for n < 2^31, results below n */
+static inline vec redc_v(vec a, vec b, vec n, vec ninv) {
+    vec t = _mm256_mul_epu32(a, b);
+    vec m = _mm256_mul_epu32(t, ninv);
+    vec r = _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(m, n)), 32);
+    return _mm256_blendv_epi8(_mm256_sub_epi64(r, n), r, _mm256_cmpgt_epi64(n, r));
+}
+
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+
+/* vectors in flight per step, enough to cover the REDC latency */
+#define UNROLL 8
+#define STEP (UNROLL * VLANES)
+
+static void batch_vector(const uint64_t *in, uint64_t *out, size_t count, uint64_t exp, const rsakey_t *key) {
+    uint64_t n = key->n[0], tmp[STEP];
+    const vec vn = vset(n);
+    const vec ninv = vset((uint32_t)key->n0inv);
+    const vec r2 = vset(key->r1[0]); /* 2^64 mod n is R^2 for R = 2^32 */
+    const vec one = vset(1);
+    vec x[UNROLL], y[UNROLL];
+    size_t i;
+    int j, u, b, top = top_bit(exp);
+
+    for (i = 0; i < count; i += STEP) {
+        size_t k = count - i < STEP ? count - i : STEP;
+        for (j = 0; j < STEP; j++) {
+            tmp[j] = (size_t)j < k ? (in[i + j] < n ? in[i + j] : in[i + j] % n) : 0;
+        }
+        for (u = 0; u < UNROLL; u++) {
+            x[u] = y[u] = redc_v(vload(tmp + u * VLANES), r2, vn, ninv);
+        }
+        for (b = top - 1; b >= 0; b--) {
+            for (u = 0; u < UNROLL; u++) {
+                y[u] = redc_v(y[u], y[u], vn, ninv);
+            }
+            if (exp >> b & 1) {
+                for (u = 0; u < UNROLL; u++) {
+                    y[u] = redc_v(y[u], x[u], vn, ninv);
+                }
+            }
+        }
+        for (u = 0; u < UNROLL; u++) {
+            vstore(tmp + u * VLANES, redc_v(y[u], one, vn, ninv));
+        }
+        for (j = 0; (size_t)j < k; j++) {
+            out[i + j] = tmp[j];
+        }
+    }
+}
+
+#endif
+
+/* can batch_vector take this key */
+static int vector_ok(const rsakey_t *key) {
+#if defined(__AVX512F__) || defined(__AVX2__)
+    return key->n[0] < SMALL_N;
+#else
+    (void)key;
+    return 0;
+#endif
+}
+
+void modexp_batch(const uint64_t *in, uint64_t *out, size_t count, uint64_t exp, const rsakey_t *key) {
+    size_t i;
+    if (exp == 0) {
+        for (i = 0; i < count; i++) {
+            out[i] = key->n[0] > 1;
+        }
+        return;
+    }
+#if defined(__AVX512F__) || defined(__AVX2__)
+    if (vector_ok(key)) {
+        batch_vector(in, out, count, exp, key);
+        return;
+    }
+#endif
+    batch_scalar(in, out, count, exp, key);
+}
+
+void rsa_pub_batch(const uint64_t *in, uint64_t *out, size_t count, const rsakey_t *key) {
+    uint64_t n = key->n[0], n0inv = key->n0inv, r2 = key->r2[0];
+    uint64_t x[LANES], y[LANES];
+    size_t i = 0;
+    int j, k;
+
+    if (key->e[0] != RSA_E || vector_ok(key)) {
+        modexp_batch(in, out, count, key->e[0], key);
+        return;
+    }
+    /* LANES independent squaring chains keep the multiplier busy */
+    for (; i + LANES <= count; i += LANES) {
+        for (j = 0; j < LANES; j++) {
+            x[j] = y[j] = redc(in[i + j], r2, n, n0inv);
+        }
+        for (k = 0; k < 16; k++) {
+            for (j = 0; j < LANES; j++) {
+                y[j] = redc(y[j], y[j], n, n0inv);
+            }
+        }
+        for (j = 0; j < LANES; j++) {
+            out[i + j] = redc(redc(y[j], x[j], n, n0inv), 1, n, n0inv);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = modexp_pub(in[i], key);
+    }
+}
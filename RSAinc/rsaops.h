@@ -0,0 +1,32 @@
+/* rsaops.h */
+
+/* word sized RSA on keys loaded through rsakey (words == 1) */
+
+#ifndef RSAOPS_H
+#define RSAOPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "rsakey.h"
+
+#define RSA_E 0x10001
+
+// a * b / R mod n, R = 2^64, for a, b < n
+uint64_t mont_mul(uint64_t a, uint64_t b, uint64_t n, uint64_t n0inv);
+
+// base^exp mod n using the key's cached montgomery constants
+uint64_t modexp(uint64_t base, uint64_t exp, const rsakey_t *key);
+
+// out[i] = in[i]^exp mod n for count words (in and out may alias), with
+// independent exponentiations interleaved; moduli below 2^31 run in
+// SIMD lanes when built with AVX2 or AVX-512
+void modexp_batch(const uint64_t *in, uint64_t *out, size_t count, uint64_t exp, const rsakey_t *key);
+
+// base^65537 mod n: 16 squarings and one multiply, no exponent scan
+uint64_t modexp_pub(uint64_t base, const rsakey_t *key);
+
+// out[i] = in[i]^e mod n for count words (in and out may alias), taking
+// the 65537 path when the key's e allows it; verify is the same operation
+void rsa_pub_batch(const uint64_t *in, uint64_t *out, size_t count, const rsakey_t *key);
+
+#endif /* RSAOPS_H */
@@ -0,0 +1,113 @@
+/* heap_bench.c - pop heavy workloads across heap arities */
+
+/*
+ * gcc -O2 heap_bench.c heap_t.c sort.c list_t.c -o heap_bench
+ *
+ * For each size n: n inserts of random uint64 keys, then n/2 rounds of
+ * (pop, insert), then pop everything. Reports ns per operation, first
+ * across arities, then generic heap_t against a HEAP_GEN heap at arity 4.
+ */
+
+#include <time.h>
+#include "heap_t.h"
+#include "heap_gen.h"
+
+static bool u64_gt(void *a, void *b) {
+    return *(uint64_t *)a > *(uint64_t *)b;
+}
+
+static inline bool u64_gen_gt(const uint64_t *a, const uint64_t *b) {
+    return *a > *b;
+}
+
+HEAP_GEN(u64_heap, uint64_t, u64_gen_gt, 4)
+
+static uint64_t seed = 88172645463325252ULL;
+
+static uint64_t rnd(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    size_t arities[] = {2, 4, 8};
+    size_t n, i, a;
+    uint64_t x, sink = 0;
+    double t[3];
+
+    printf("%10s %12s %12s %12s   (ns per op, insert / pop-insert / pop)\n", "n", "arity 2", "arity 4", "arity 8");
+    for (n = 1000; n <= 10000000; n *= 10) {
+        for (a = 0; a < 3; a++) {
+            heap_t h = heap_new_d(sizeof(uint64_t), u64_gt, arities[a]);
+            double start = now();
+            seed = 88172645463325252ULL;
+            for (i = 0; i < n; i++) {
+                x = rnd();
+                heap_insert(&h, &x);
+            }
+            for (i = 0; i < n / 2; i++) {
+                heap_maxpop(&h, &x);
+                sink += x;
+                x = rnd();
+                heap_insert(&h, &x);
+            }
+            while (heap_maxpop(&h, &x)) {
+                sink += x;
+            }
+            t[a] = (now() - start) / (double)(3 * n);
+            heap_free(&h);
+        }
+        printf("%10lu %12.1f %12.1f %12.1f\n", n, t[0], t[1], t[2]);
+    }
+
+    printf("\n%10s %12s %12s   (ns per op, arity 4)\n", "n", "heap_t", "HEAP_GEN");
+    for (n = 1000; n <= 10000000; n *= 10) {
+        heap_t h = heap_new_d(sizeof(uint64_t), u64_gt, 4);
+        u64_heap g = u64_heap_new();
+        double start = now();
+        seed = 88172645463325252ULL;
+        for (i = 0; i < n; i++) {
+            x = rnd();
+            heap_insert(&h, &x);
+        }
+        for (i = 0; i < n / 2; i++) {
+            heap_maxpop(&h, &x);
+            sink += x;
+            x = rnd();
+            heap_insert(&h, &x);
+        }
+        while (heap_maxpop(&h, &x)) {
+            sink += x;
+        }
+        t[0] = (now() - start) / (double)(3 * n);
+        heap_free(&h);
+
+        start = now();
+        seed = 88172645463325252ULL;
+        for (i = 0; i < n; i++) {
+            x = rnd();
+            u64_heap_insert(&g, &x);
+        }
+        for (i = 0; i < n / 2; i++) {
+            u64_heap_maxpop(&g, &x);
+            sink += x;
+            x = rnd();
+            u64_heap_insert(&g, &x);
+        }
+        while (u64_heap_maxpop(&g, &x)) {
+            sink += x;
+        }
+        t[1] = (now() - start) / (double)(3 * n);
+        u64_heap_free(&g);
+        printf("%10lu %12.1f %12.1f\n", n, t[0], t[1]);
+    }
+    return sink == 42;
+}
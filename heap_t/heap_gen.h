@@ -0,0 +1,149 @@
+#ifndef _HEAP_GEN_H_
+#define _HEAP_GEN_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "list_t.h"
+
+/*
+ * Type specialized heaps. heap_t moves ele_size bytes with memcpy and
+ * compares through a function pointer; HEAP_GEN stamps out a heap for one
+ * element type and one comparator, so moves are plain assignments and the
+ * comparator is inlined.
+ *
+ *   static inline bool u64_gt(const uint64_t *a, const uint64_t *b) {
+ *       return *a > *b;
+ *   }
+ *   HEAP_GEN(u64_heap, uint64_t, u64_gt, 4)
+ *
+ * defines the type u64_heap and
+ *
+ *   u64_heap u64_heap_new(void);
+ *   u64_heap u64_heap_from_array(const uint64_t *eles, size_t count);
+ *   void u64_heap_free(u64_heap *h);
+ *   void u64_heap_insert(u64_heap *h, const uint64_t *ele);
+ *   bool u64_heap_maxpop(u64_heap *h, uint64_t *out);
+ *   const uint64_t *u64_heap_peek(u64_heap *h);  // NULL if empty
+ *
+ * gt(a, b) takes two const name_type * (name_type is type, so for
+ * char * that is char *const *) and is true if a belongs above b. The
+ * arity must be a constant of at least 2. Storage uses the same layout
+ * and alignment as heap_t: element i lives in slot i + arity - 1.
+ */
+
+#define HEAP_GEN_LINE 64
+
+#define HEAP_GEN(name, type, gt, arity)                                        \
+                                                                               \
+/* A typedef, so const applies to the element even for pointer types */        \
+typedef type name##_type;                                                      \
+                                                                               \
+typedef struct name##_struct {                                                 \
+  name##_type *eles;      /* Aligned slots, element i at i + arity - 1 */     \
+  size_t capacity;        /* Current capacity of the heap */                  \
+  size_t size;            /* Current number of elements in the heap */        \
+} name;                                                                        \
+                                                                               \
+static inline void name##_set_capacity(name *h, size_t capacity) {             \
+    void *eles;                                                                \
+    if (posix_memalign(&eles, HEAP_GEN_LINE,                                   \
+                       (capacity + (arity) - 1) * sizeof(name##_type))) {      \
+        fprintf(stderr, "Failed to allocate memory for heap\n");               \
+        exit(EXIT_FAILURE);                                                    \
+    }                                                                          \
+    if (h->eles) {                                                             \
+        memcpy(eles, h->eles, (h->size + (arity) - 1) * sizeof(name##_type));  \
+        free(h->eles);                                                         \
+    }                                                                          \
+    h->eles = eles;                                                            \
+    h->capacity = capacity;                                                    \
+}                                                                              \
+                                                                               \
+/* Sift ele up from the hole at index */                                       \
+static inline void name##_up(name *h, size_t index, const name##_type *ele) {  \
+    name##_type *e = h->eles + (arity) - 1;                                    \
+    name##_type x = *ele;                                                      \
+    size_t parent;                                                             \
+    while (index > 0 && gt(&x, &e[parent = (index - 1) / (arity)])) {          \
+        e[index] = e[parent];                                                  \
+        index = parent;                                                        \
+    }                                                                          \
+    e[index] = x;                                                              \
+}                                                                              \
+                                                                               \
+/* Sift ele down from the hole at index, largest child moves up */             \
+static inline void name##_down(name *h, size_t index,                         \
+                               const name##_type *ele) {                       \
+    name##_type *e = h->eles + (arity) - 1;                                    \
+    name##_type x = *ele;                                                      \
+    size_t child, last, c;                                                     \
+    while ((child = index * (arity) + 1) < h->size) {                          \
+        last = child + (arity) < h->size ? child + (arity) : h->size;          \
+        for (c = child + 1; c < last; c++) {                                   \
+            if (gt(&e[c], &e[child])) {                                        \
+                child = c;                                                     \
+            }                                                                  \
+        }                                                                      \
+        if (!gt(&e[child], &x)) {                                              \
+            break;                                                             \
+        }                                                                      \
+        e[index] = e[child];                                                   \
+        index = child;                                                         \
+    }                                                                          \
+    e[index] = x;                                                              \
+}                                                                              \
+                                                                               \
+static inline name name##_new(void) {                                          \
+    name h = {NULL, 0, 0};                                                     \
+    name##_set_capacity(&h, 10);                                               \
+    return h;                                                                  \
+}                                                                              \
+                                                                               \
+/* Build from count elements in O(n) (Floyd) */                                \
+static inline name name##_from_array(const name##_type *eles, size_t count) {  \
+    name h = {NULL, 0, 0};                                                     \
+    size_t i;                                                                  \
+    name##_set_capacity(&h, count ? count : 1);                                \
+    memcpy(h.eles + (arity) - 1, eles, count * sizeof(name##_type));           \
+    h.size = count;                                                            \
+    if (count > 1) {                                                           \
+        for (i = (count - 2) / (arity) + 1; i-- > 0;) {                        \
+            name##_down(&h, i, &h.eles[i + (arity) - 1]);                      \
+        }                                                                      \
+    }                                                                          \
+    return h;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void name##_free(name *h) {                                      \
+    free(h->eles);                                                             \
+    h->eles = NULL;                                                            \
+    h->size = h->capacity = 0;                                                 \
+}                                                                              \
+                                                                               \
+static inline void name##_insert(name *h, const name##_type *ele) {            \
+    if (h->size >= h->capacity) {                                              \
+        name##_set_capacity(h, h->capacity ? h->capacity * 2 : 10);            \
+    }                                                                          \
+    h->size++;                                                                 \
+    name##_up(h, h->size - 1, ele);                                            \
+}                                                                              \
+                                                                               \
+static inline bool name##_maxpop(name *h, name##_type *out) {                  \
+    if (h->size == 0) {                                                        \
+        return FALSE;                                                          \
+    }                                                                          \
+    *out = h->eles[(arity) - 1];                                               \
+    h->size--;                                                                 \
+    if (h->size > 0) {                                                         \
+        name##_down(h, 0, &h->eles[h->size + (arity) - 1]);                    \
+    }                                                                          \
+    return TRUE;                                                               \
+}                                                                              \
+                                                                               \
+static inline const name##_type *name##_peek(name *h) {                        \
+    return h->size ? &h->eles[(arity) - 1] : NULL;                             \
+}
+
+#endif /* _HEAP_GEN_H_ */
@@ -1,138 +1,179 @@
 #include "heap_t.h"
+#include "sort.h"
 
-// Macros for calculating parent and child indices (1-indexed array)
-#define PARENT(i) ((i) / 2)
-#define LEFT(i) ((i) * 2)
-#define RIGHT(i) ((i) * 2 + 1)
+// Elements are numbered from 0 and element i lives in slot i + arity - 1,
+// so every group of siblings starts on a slot that is a multiple of the
+// arity. With arity 2 this is the classic 1-indexed layout (slot 0 unused).
+#define PARENT(h, i) (((i) - 1) / (h)->arity)
+#define CHILD(h, i) ((i) * (h)->arity + 1)
+
+// Storage is aligned so sibling groups of arity * ele_size bytes (a
+// divisor or multiple of 64) never straddle a cache line
+#define LINE 64
 
 // Helper function to get the address of an element at a given index
-static void *get_element(heap_t h, size_t index) {
-    // Adjusted for 1-indexed array (index 0 is not used)
-    return (char *)h.eles + (index * h.ele_size);
+static void *get_element(heap_t *h, size_t index) {
+    return (char *)h->eles + ((index + h->arity - 1) * h->ele_size);
 }
 
-// Helper function to swap two elements in the heap
-static void swap_elements(heap_t h, size_t i, size_t j) {
-    void *temp = malloc(h.ele_size);
-    if (!temp) {
-        fprintf(stderr, "Failed to allocate memory for swap\n");
+// Helper function to (re)size the aligned element storage
+static void set_capacity(heap_t *h, size_t capacity) {
+    void *eles;
+    if (posix_memalign(&eles, LINE, (capacity + h->arity - 1) * h->ele_size)) {
+        fprintf(stderr, "Failed to allocate memory for heap\n");
         exit(EXIT_FAILURE);
     }
-    
-    void *ei = get_element(h, i);
-    void *ej = get_element(h, j);
-    
-    memcpy(temp, ei, h.ele_size);
-    memcpy(ei, ej, h.ele_size);
-    memcpy(ej, temp, h.ele_size);
-    
-    free(temp);
+    if (h->eles) {
+        memcpy(eles, h->eles, (h->size + h->arity - 1) * h->ele_size);
+        free(h->eles);
+    }
+    h->eles = eles;
+    h->capacity = capacity;
 }
 
-// Helper function to heapify downward from a given index
-static void heapify_down(heap_t h, size_t index) {
-    size_t largest = index;
-    size_t left = LEFT(index);
-    size_t right = RIGHT(index);
-    
-    // Check if left child is larger than the current largest
-    if (left <= h.size && h.gt(get_element(h, left), get_element(h, largest))) {
-        largest = left;
-    }
-    
-    // Check if right child is larger than the current largest
-    if (right <= h.size && h.gt(get_element(h, right), get_element(h, largest))) {
-        largest = right;
-    }
-    
-    // If largest is not the current index, swap and continue heapifying
-    if (largest != index) {
-        swap_elements(h, index, largest);
-        heapify_down(h, largest);
+// Sift ele up from the hole at index, moving each smaller parent down
+// into the hole (one copy per level), then drop ele into the final hole
+static void heapify_up(heap_t *h, size_t index, void *ele) {
+    while (index > 0 && h->gt(ele, get_element(h, PARENT(h, index)))) {
+        memcpy(get_element(h, index), get_element(h, PARENT(h, index)), h->ele_size);
+        index = PARENT(h, index);
     }
+    memcpy(get_element(h, index), ele, h->ele_size);
 }
 
-// Helper function to heapify upward from a given index
-static void heapify_up(heap_t h, size_t index) {
-    // If we're at the root or the parent is greater, stop
-    if (index <= 1 || !h.gt(get_element(h, index), get_element(h, PARENT(index)))) {
-        return;
+// Sift ele down from the hole at index, moving the largest child up into
+// the hole while it beats ele. ele must not live inside the heap.
+static void heapify_down(heap_t *h, size_t index, void *ele) {
+    size_t child, last, c;
+    while ((child = CHILD(h, index)) < h->size) {
+        // Pick the largest of the (contiguous) children
+        last = child + h->arity < h->size ? child + h->arity : h->size;
+        for (c = child + 1; c < last; c++) {
+            if (h->gt(get_element(h, c), get_element(h, child))) {
+                child = c;
+            }
+        }
+        if (!h->gt(get_element(h, child), ele)) {
+            break;
+        }
+        memcpy(get_element(h, index), get_element(h, child), h->ele_size);
+        index = child;
     }
-    
-    // Swap with parent and continue heapifying upward
-    swap_elements(h, index, PARENT(index));
-    heapify_up(h, PARENT(index));
+    memcpy(get_element(h, index), ele, h->ele_size);
 }
 
 // Initialize a new heap
 heap_t heap_new(size_t ele_size, bool (*gt)(void *, void *)) {
+    return heap_new_d(ele_size, gt, 2);
+}
+
+// Helper function to set up an empty heap with room for capacity elements
+static heap_t heap_init(size_t ele_size, bool (*gt)(void *, void *), size_t arity, size_t capacity) {
     heap_t h;
     h.ele_size = ele_size;
     h.gt = gt;
+    h.arity = arity < 2 ? 2 : arity;
+    h.eles = NULL;
     h.size = 0;
-    h.capacity = 10;  // Initial capacity
-    
-    // Allocate memory for elements (+1 for 1-indexed)
-    h.eles = malloc((h.capacity + 1) * h.ele_size);
-    if (!h.eles) {
-        fprintf(stderr, "Failed to allocate memory for heap\n");
-        exit(EXIT_FAILURE);
+    set_capacity(&h, capacity ? capacity : 1);
+    return h;
+}
+
+// Floyd's bottom-up heapify of the first h->size elements, O(n). Slot 0
+// is never an element (the root is slot arity - 1), so it holds the one
+// element being sifted.
+static void heapify_all(heap_t *h) {
+    void *scratch = h->eles;
+    size_t i;
+    if (h->size < 2) {
+        return;
     }
-    
+    for (i = PARENT(h, h->size - 1) + 1; i-- > 0;) {
+        memcpy(scratch, get_element(h, i), h->ele_size);
+        heapify_down(h, i, scratch);
+    }
+}
+
+// Initialize a new heap with the given number of children per node
+heap_t heap_new_d(size_t ele_size, bool (*gt)(void *, void *), size_t arity) {
+    return heap_init(ele_size, gt, arity, 10);  // Initial capacity
+}
+
+// Build a heap from count elements of an array in O(n)
+heap_t heap_from_array(size_t ele_size, bool (*gt)(void *, void *), size_t arity, void *eles, size_t count) {
+    heap_t h = heap_init(ele_size, gt, arity, count);
+    memcpy(get_element(&h, 0), eles, count * ele_size);
+    h.size = count;
+    heapify_all(&h);
     return h;
 }
 
 // Free the heap and its elements
-void heap_free(heap_t h) {
-    if (h.eles) {
-        free(h.eles);
+void heap_free(heap_t *h) {
+    if (h->eles) {
+        free(h->eles);
+        h->eles = NULL;
     }
+    h->size = h->capacity = 0;
 }
 
 // Insert an element into the heap
-void heap_insert(heap_t h, void *ele) {
+void heap_insert(heap_t *h, void *ele) {
     // Check if we need to resize
-    if (h.size >= h.capacity) {
-        h.capacity *= 2;
-        h.eles = realloc(h.eles, (h.capacity + 1) * h.ele_size);
-        if (!h.eles) {
-            fprintf(stderr, "Failed to reallocate memory for heap\n");
-            exit(EXIT_FAILURE);
-        }
+    if (h->size >= h->capacity) {
+        set_capacity(h, h->capacity ? h->capacity * 2 : 10);
     }
     
-    // Insert the new element at the end of the heap
-    h.size++;
-    memcpy(get_element(h, h.size), ele, h.ele_size);
-    
-    // Restore the heap property by heapifying up
-    heapify_up(h, h.size);
+    // Open a hole at the end of the heap and sift the new element up
+    h->size++;
+    heapify_up(h, h->size - 1, ele);
 }
 
-// Remove and return the maximum element from the heap
-void *heap_maxpop(heap_t h) {
-    if (h.size == 0) {
-        return NULL;  // Heap is empty
+// Copy the maximum element into out and remove it from the heap
+bool heap_maxpop(heap_t *h, void *out) {
+    if (h->size == 0) {
+        return FALSE;  // Heap is empty
     }
     
-    // Get the maximum element (root)
-    void *max_ele = malloc(h.ele_size);
-    if (!max_ele) {
-        fprintf(stderr, "Failed to allocate memory for maxpop\n");
-        exit(EXIT_FAILURE);
-    }
-    memcpy(max_ele, get_element(h, 1), h.ele_size);
-    
-    // Replace the root with the last element
-    memcpy(get_element(h, 1), get_element(h, h.size), h.ele_size);
-    h.size--;
+    memcpy(out, get_element(h, 0), h->ele_size);
     
-    // Restore the heap property by heapifying down
-    if (h.size > 0) {
-        heapify_down(h, 1);
+    // The last element fills the root hole; it sits just past the new end
+    // of the heap, so it can be sifted down without a temporary copy
+    h->size--;
+    if (h->size > 0) {
+        heapify_down(h, 0, get_element(h, h->size));
     }
     
-    return max_ele;
+    return TRUE;
+}
+
+// Address of the maximum element, valid until the heap is next changed
+void *heap_peek(heap_t *h) {
+    return h->size ? get_element(h, 0) : NULL;
+}
+
+// Insert then pop in one sift: if ele would come straight back out the
+// heap is untouched, otherwise it takes the root's place. ele is parked
+// in the unused slot 0 first, so out may alias it.
+void heap_pushpop(heap_t *h, void *ele, void *out) {
+    if (h->size == 0 || !h->gt(get_element(h, 0), ele)) {
+        memmove(out, ele, h->ele_size);
+        return;
+    }
+    memcpy(h->eles, ele, h->ele_size);
+    memcpy(out, get_element(h, 0), h->ele_size);
+    heapify_down(h, 0, h->eles);
+}
+
+// Pop then insert in one sift, ele replaces the root
+bool heap_replace(heap_t *h, void *ele, void *out) {
+    if (h->size == 0) {
+        return FALSE;  // Heap is empty
+    }
+    memcpy(h->eles, ele, h->ele_size);
+    memcpy(out, get_element(h, 0), h->ele_size);
+    heapify_down(h, 0, h->eles);
+    return TRUE;
 }
 
 // Helper function for pointer comparison in the heap (treats pointers as integers)
@@ -141,50 +182,46 @@ static bool pointer_greater_than(void *a, void *b) {
 }
 
 heap_t l_to_h(list_t l) {
-    // Count elements in the list
-    size_t count = 0;
-    list_t current = l;
-    while (current != NULL && current[0] != NULL) {
-        count++;
-        current = (list_t)current[1];
-    }
-    
-    // Create a new heap with a comparison function for pointers
-    heap_t h = heap_new(sizeof(void*), pointer_greater_than);
+    // Create a heap sized exactly for the list, with a comparison
+    // function for pointers
+    heap_t h = heap_init(sizeof(void*), pointer_greater_than, 2, list_len(l));
     
-    // Insert all elements from the list into the heap
-    current = l;
-    while (current != NULL && current[0] != NULL) {
-        void *element = current[0];
-        heap_insert(h, &element);
-        current = (list_t)current[1];
+    // Copy the elements straight into the heap storage, then heapify once
+    list_cursor c;
+    void *element;
+    for (c = list_begin(l); !list_done(&c); list_next(&c)) {
+        element = list_get(&c);
+        memcpy(get_element(&h, h.size++), &element, sizeof(void*));
     }
+    heapify_all(&h);
     
     return h;
 }
 
 void h_sort(list_t l) {
     // Return if the list is empty or has only one element
-    if (l == NULL || l[0] == NULL || l[1] == NULL) {
+    if (l == NULL || list_len(l) < 2) {
         return;
     }
     
-    // Create a heap from the list
-    heap_t h = l_to_h(l);
-    
-    // Clear the original list
-    list_clear(l);
+    // Gather the elements into one array; they compare as integers, so
+    // radix sort them
+    size_t count = list_len(l), i;
+    list_cursor c;
+    uint64_t *keys = (uint64_t *)malloc(count * sizeof(uint64_t));
+    if (keys == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    for (c = list_begin(l), i = 0; i < count; list_next(&c), i++) {
+        keys[i] = (uint64_t)(uintptr_t)list_get(&c);
+    }
+    radix_sort_u64(keys, count);
     
-    // Extract elements from the heap in sorted order (largest to smallest)
-    // and append them to the list
-    void *element;
-    while ((element = heap_maxpop(h)) != NULL) {
-        // For a max heap, we get elements in descending order
-        // So we prepend to the list to get ascending order
-        list_insert(l, 0, *(void**)element);
-        free(element);  // Free the memory allocated by heap_maxpop
+    // Write back in ascending order into the existing nodes
+    for (c = list_begin(l), i = 0; i < count; list_next(&c), i++) {
+        list_set(&c, (void *)(uintptr_t)keys[i]);
     }
     
-    // Free the heap structure
-    heap_free(h);
-}
\ No newline at end of file
+    free(keys);
+}
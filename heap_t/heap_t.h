@@ -11,6 +11,7 @@
 typedef struct heap_struct {
   size_t ele_size;        // Size of each element
   bool (*gt)(void *, void *); // Greater than comparison function
+  size_t arity;           // Children per node (2 = binary heap)
   void *eles;             // Array to store elements
   size_t capacity;        // Current capacity of the heap
   size_t size;            // Current number of elements in the heap
@@ -19,20 +20,37 @@ typedef struct heap_struct {
 // Initialize a new heap
 heap_t heap_new(size_t ele_size, bool (*gt)(void *, void *));
 
+// Initialize a new d-ary heap; 4 or 8 cut cache misses on large heaps
+heap_t heap_new_d(size_t ele_size, bool (*gt)(void *, void *), size_t arity);
+
+// Build a heap from count elements copied out of eles, in O(n)
+heap_t heap_from_array(size_t ele_size, bool (*gt)(void *, void *), size_t arity, void *eles, size_t count);
+
 // Free the heap and its elements
-void heap_free(heap_t h);
+void heap_free(heap_t *h);
+
+// Insert an element into the heap (copies ele_size bytes from ele)
+void heap_insert(heap_t *h, void *ele);
+
+// Remove the maximum element into out; returns FALSE if the heap is empty
+bool heap_maxpop(heap_t *h, void *out);
+
+// Address of the maximum element, NULL if the heap is empty
+void *heap_peek(heap_t *h);
 
-// Insert an element into the heap
-void heap_insert(heap_t h, void *ele);
+// Insert ele then remove the maximum into out, with at most one sift;
+// out may be ele
+void heap_pushpop(heap_t *h, void *ele, void *out);
 
-// Remove and return the maximum element from the heap
-void *heap_maxpop(heap_t h);
+// Remove the maximum into out then insert ele, with one sift; returns
+// FALSE (and inserts nothing) if the heap is empty; out may be ele
+bool heap_replace(heap_t *h, void *ele, void *out);
 
 
 // Convert a list to a heap
 heap_t l_to_h(list_t l);
 
-// Sort a list using heap sort
+// Sort a list in ascending order, reusing its nodes
 void h_sort(list_t l);
 
 #endif /* _HEAP_T_H_ */
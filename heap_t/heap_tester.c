@@ -0,0 +1,263 @@
+/* heap_tester.c */
+
+/* tests heap_t.c functionality */
+
+#include "heap_t.h"
+#include "heap_gen.h"
+#include "iheap.h"
+#include "sort.h"
+#include "topk.h"
+
+static bool int_gt(void *a, void *b) {
+    return *(int *)a > *(int *)b;
+}
+
+typedef struct digest {
+    uint8_t b[32];
+} digest;
+
+static inline bool digest_gt(const digest *a, const digest *b) {
+    return memcmp(a->b, b->b, 32) > 0;
+}
+
+static inline bool int_lt(const int *a, const int *b) {
+    return *a < *b;
+}
+
+static inline bool str_gt(char *const *a, char *const *b) {
+    return strcmp(*a, *b) > 0;
+}
+
+HEAP_GEN(digest_heap, digest, digest_gt, 4)
+HEAP_GEN(int_minheap, int, int_lt, 2)
+HEAP_GEN(str_heap, char *, str_gt, 4)
+
+int main()
+{
+    heap_t h = heap_new(sizeof(int), int_gt);
+    list_t l = list_new();
+    int vals[] = {5, 1, 9, 3, 7}, x, prev, ok;
+    size_t arities[] = {3, 4, 8};
+    size_t i, d;
+    digest_heap dh;
+    int_minheap mh;
+    str_heap sh;
+    char *words[] = {"pear", "fig", "apple", "kiwi"}, *w;
+    digest dg;
+    iheap_t ih;
+    size_t hs[5];
+    int *arr;
+    uint64_t *keys;
+    topk_t tk;
+    int best[3];
+
+    /* Test insert and maxpop */
+
+    printf("\n0. Insert and maxpop\n");
+    printf("Insert 5, 1, 9, 3, 7 then pop all, should print:\n");
+    printf("9 7 5 3 1 (empty)\n");
+    printf("Does print:\n");
+    for (i = 0; i < 5; i++) {
+        heap_insert(&h, &vals[i]);
+    }
+    while (heap_maxpop(&h, &x)) {
+        printf("%d ", x);
+    }
+    printf("(empty)\n");
+
+    /* Test growth */
+
+    printf("\n1. Growth\n");
+    printf("Insert 100000 values, size and ordered pops should print:\n");
+    printf("100000 1\n");
+    printf("Does print:\n");
+    srand(1);
+    for (i = 0; i < 100000; i++) {
+        x = rand();
+        heap_insert(&h, &x);
+    }
+    printf("%lu ", h.size);
+    ok = heap_maxpop(&h, &prev);
+    while (heap_maxpop(&h, &x)) {
+        ok = ok && x <= prev;
+        prev = x;
+    }
+    printf("%d\n", ok);
+    heap_free(&h);
+
+    /* Test arity */
+
+    printf("\n2. Arity\n");
+    printf("Ordered pops of 100000 values with arity 3, 4 and 8 should print:\n");
+    printf("1 1 1\n");
+    printf("Does print:\n");
+    for (d = 0; d < 3; d++) {
+        h = heap_new_d(sizeof(int), int_gt, arities[d]);
+        for (i = 0; i < 100000; i++) {
+            x = rand();
+            heap_insert(&h, &x);
+        }
+        ok = h.size == 100000 && heap_maxpop(&h, &prev);
+        while (heap_maxpop(&h, &x)) {
+            ok = ok && x <= prev;
+            prev = x;
+        }
+        printf(d == 2 ? "%d\n" : "%d ", ok);
+        heap_free(&h);
+    }
+
+    /* Test bulk build */
+
+    printf("\n3. Bulk build\n");
+    printf("Building from 5, 1, 9, 3, 7 then popping all should print:\n");
+    printf("9 7 5 3 1 (empty)\n");
+    printf("Does print:\n");
+    h = heap_from_array(sizeof(int), int_gt, 4, vals, 5);
+    while (heap_maxpop(&h, &x)) {
+        printf("%d ", x);
+    }
+    printf("(empty)\n");
+    heap_free(&h);
+
+    /* Test h_sort */
+
+    printf("\n4. Heap sort\n");
+    printf("Sorting [3, 1, 4, 1, 5] should print:\n");
+    printf("[1, 1, 3, 4, 5]\n");
+    printf("Does print:\n");
+    list_append(l, (void *)3);
+    list_append(l, (void *)1);
+    list_append(l, (void *)4);
+    list_append(l, (void *)1);
+    list_append(l, (void *)5);
+    h_sort(l);
+    list_print(l);
+    list_free(l);
+
+    /* Test generated heaps */
+
+    printf("\n5. Generated heap\n");
+    printf("Min heap from 5, 1, 9, 3, 7 popped, then 100000 digests popped in order,\n");
+    printf("then a heap of char * from pear, fig, apple, kiwi popped, should print:\n");
+    printf("1 3 5 7 9 1\n");
+    printf("pear kiwi fig apple\n");
+    printf("Does print:\n");
+    mh = int_minheap_from_array(vals, 5);
+    while (int_minheap_maxpop(&mh, &x)) {
+        printf("%d ", x);
+    }
+    int_minheap_free(&mh);
+    dh = digest_heap_new();
+    for (i = 0; i < 100000; i++) {
+        for (d = 0; d < 32; d++) {
+            dg.b[d] = (uint8_t)rand();
+        }
+        digest_heap_insert(&dh, &dg);
+    }
+    ok = dh.size == 100000;
+    while (digest_heap_maxpop(&dh, &dg)) {
+        ok = ok && (!digest_heap_peek(&dh) || !digest_gt(digest_heap_peek(&dh), &dg));
+    }
+    printf("%d\n", ok);
+    digest_heap_free(&dh);
+    sh = str_heap_from_array(words, 4);
+    while (str_heap_maxpop(&sh, &w)) {
+        printf(sh.size ? "%s " : "%s\n", w);
+    }
+    str_heap_free(&sh);
+
+    /* Test indexed heap */
+
+    printf("\n6. Indexed heap\n");
+    printf("Insert 5, 1, 9, 3, 7, raise 1 to 8, remove 9, reuse its handle for 6, should print:\n");
+    printf("8 7 6 5 3 (empty) 1\n");
+    printf("Does print:\n");
+    ih = iheap_new(sizeof(int), int_gt);
+    for (i = 0; i < 5; i++) {
+        hs[i] = iheap_insert(&ih, &vals[i]);
+    }
+    x = 8;
+    iheap_update_key(&ih, hs[1], &x);
+    iheap_remove(&ih, hs[2], NULL);
+    x = 6;
+    ok = iheap_insert(&ih, &x) == hs[2];
+    while (iheap_maxpop(&ih, &x, NULL)) {
+        printf("%d ", x);
+    }
+    printf("(empty) %d\n", ok && !iheap_remove(&ih, hs[0], NULL));
+    iheap_free(&ih);
+
+    /* Test array sorts */
+
+    printf("\n7. Array sort\n");
+    printf("Sorting 5, 1, 9, 3, 7, then 100000 ints (many equal) and 100000 u64 keys should print:\n");
+    printf("1 3 5 7 9 1 1\n");
+    printf("Does print:\n");
+    sort_array(vals, 5, sizeof(int), int_gt);
+    for (i = 0; i < 5; i++) {
+        printf("%d ", vals[i]);
+    }
+    arr = malloc(100000 * sizeof(int));
+    keys = malloc(100000 * sizeof(uint64_t));
+    for (i = 0; i < 100000; i++) {
+        arr[i] = rand() % 100;
+        keys[i] = (uint64_t)rand() << 33 ^ (uint64_t)rand();
+    }
+    sort_array(arr, 100000, sizeof(int), int_gt);
+    radix_sort_u64(keys, 100000);
+    ok = 1;
+    for (i = 1; i < 100000; i++) {
+        ok = ok && arr[i - 1] <= arr[i];
+    }
+    printf("%d ", ok);
+    ok = 1;
+    for (i = 1; i < 100000; i++) {
+        ok = ok && keys[i - 1] <= keys[i];
+    }
+    printf("%d\n", ok);
+    free(arr);
+    free(keys);
+
+    /* Test fused operations */
+
+    printf("\n8. Push-pop and replace\n");
+    printf("Heap of 5, 3: pushpop 9, pushpop 4, replace with 8, then pop all, should print:\n");
+    printf("9 5 4 8 3\n");
+    printf("Does print:\n");
+    h = heap_new(sizeof(int), int_gt);
+    x = 5;
+    heap_insert(&h, &x);
+    x = 3;
+    heap_insert(&h, &x);
+    x = 9;
+    heap_pushpop(&h, &x, &x);
+    printf("%d ", x);
+    x = 4;
+    heap_pushpop(&h, &x, &x);
+    printf("%d ", x);
+    x = 8;
+    heap_replace(&h, &x, &x);
+    printf("%d", x);
+    while (heap_maxpop(&h, &x)) {
+        printf(" %d", x);
+    }
+    printf("\n");
+    heap_free(&h);
+
+    /* Test top-k */
+
+    printf("\n9. Top-k\n");
+    printf("Top 3 of 0 .. 99999 shuffled, and capacity after, should print:\n");
+    printf("99999 99998 99997 3\n");
+    printf("Does print:\n");
+    tk = topk_new(sizeof(int), int_gt, 3);
+    for (i = 0; i < 100000; i++) {
+        x = (int)((i * 7919) % 100000);
+        topk_push(&tk, &x);
+    }
+    topk_drain(&tk, best);
+    printf("%d %d %d %lu\n", best[0], best[1], best[2], tk.k);
+    topk_free(&tk);
+
+    return 0;
+}
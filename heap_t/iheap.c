@@ -0,0 +1,175 @@
+#include "iheap.h"
+
+#define PARENT(i) (((i) - 1) / 2)
+#define CHILD(i) (2 * (i) + 1)
+
+// Helper function to get the address of a handle's element
+static void *get_element(iheap_t *h, size_t handle) {
+    return (char *)h->eles + handle * h->ele_size;
+}
+
+// Helper function to put a handle at a heap position
+static void place(iheap_t *h, size_t index, size_t handle) {
+    h->heap[index] = handle;
+    h->pos[handle] = index;
+}
+
+// Helper function to grow the handle arrays
+static void set_capacity(iheap_t *h, size_t capacity) {
+    void *eles = realloc(h->eles, capacity * h->ele_size);
+    size_t *pos = realloc(h->pos, capacity * sizeof(size_t));
+    size_t *heap = realloc(h->heap, capacity * sizeof(size_t));
+    if (!eles || !pos || !heap) {
+        fprintf(stderr, "Failed to allocate memory for heap\n");
+        exit(EXIT_FAILURE);
+    }
+    h->eles = eles;
+    h->pos = pos;
+    h->heap = heap;
+    h->capacity = capacity;
+}
+
+// Sift handle up from the hole at index, moving smaller parents down
+static size_t heapify_up(iheap_t *h, size_t index, size_t handle) {
+    void *ele = get_element(h, handle);
+    while (index > 0 && h->gt(ele, get_element(h, h->heap[PARENT(index)]))) {
+        place(h, index, h->heap[PARENT(index)]);
+        index = PARENT(index);
+    }
+    place(h, index, handle);
+    return index;
+}
+
+// Sift handle down from the hole at index, moving the larger child up
+static void heapify_down(iheap_t *h, size_t index, size_t handle) {
+    void *ele = get_element(h, handle);
+    size_t child;
+    while ((child = CHILD(index)) < h->size) {
+        if (child + 1 < h->size
+            && h->gt(get_element(h, h->heap[child + 1]), get_element(h, h->heap[child]))) {
+            child++;
+        }
+        if (!h->gt(get_element(h, h->heap[child]), ele)) {
+            break;
+        }
+        place(h, index, h->heap[child]);
+        index = child;
+    }
+    place(h, index, handle);
+}
+
+// Helper function to refill the hole at index with handle, in whichever
+// direction the heap order needs
+static void fix(iheap_t *h, size_t index, size_t handle) {
+    if (heapify_up(h, index, handle) == index) {
+        heapify_down(h, index, handle);
+    }
+}
+
+// Helper function to take the handle at index out of the heap; the last
+// element fills the hole and the freed handle joins the free handles
+static void take(iheap_t *h, size_t index) {
+    size_t handle = h->heap[index], last;
+    h->size--;
+    last = h->heap[h->size];
+    h->heap[h->size] = handle;
+    h->pos[handle] = IHEAP_NONE;
+    if (index < h->size) {
+        fix(h, index, last);
+    }
+}
+
+// Initialize a new indexed heap
+iheap_t iheap_new(size_t ele_size, bool (*gt)(void *, void *)) {
+    iheap_t h;
+    h.ele_size = ele_size;
+    h.gt = gt;
+    h.eles = NULL;
+    h.pos = NULL;
+    h.heap = NULL;
+    h.next = 0;
+    h.size = 0;
+    set_capacity(&h, 10);  // Initial capacity
+    return h;
+}
+
+// Free the heap and its elements
+void iheap_free(iheap_t *h) {
+    free(h->eles);
+    free(h->pos);
+    free(h->heap);
+    h->eles = NULL;
+    h->pos = h->heap = NULL;
+    h->size = h->next = h->capacity = 0;
+}
+
+// Insert an element, reusing a free handle if there is one
+size_t iheap_insert(iheap_t *h, void *ele) {
+    size_t handle;
+    if (h->size < h->next) {
+        handle = h->heap[h->size];
+    } else {
+        if (h->next >= h->capacity) {
+            set_capacity(h, h->capacity ? h->capacity * 2 : 10);
+        }
+        handle = h->next++;
+    }
+    memcpy(get_element(h, handle), ele, h->ele_size);
+    h->size++;
+    heapify_up(h, h->size - 1, handle);
+    return handle;
+}
+
+// Copy the maximum element into out and remove it from the heap
+bool iheap_maxpop(iheap_t *h, void *out, size_t *handle) {
+    if (h->size == 0) {
+        return FALSE;  // Heap is empty
+    }
+    memcpy(out, get_element(h, h->heap[0]), h->ele_size);
+    if (handle) {
+        *handle = h->heap[0];
+    }
+    take(h, 0);
+    return TRUE;
+}
+
+// Address of the maximum element, valid until the heap is next changed
+void *iheap_peek(iheap_t *h, size_t *handle) {
+    if (h->size == 0) {
+        return NULL;
+    }
+    if (handle) {
+        *handle = h->heap[0];
+    }
+    return get_element(h, h->heap[0]);
+}
+
+// Address of the element of a live handle
+void *iheap_get(iheap_t *h, size_t handle) {
+    if (handle >= h->next || h->pos[handle] == IHEAP_NONE) {
+        return NULL;
+    }
+    return get_element(h, handle);
+}
+
+// Replace the element of a live handle and sift it to its new place
+bool iheap_update_key(iheap_t *h, size_t handle, void *ele) {
+    if (!iheap_get(h, handle)) {
+        return FALSE;
+    }
+    memcpy(get_element(h, handle), ele, h->ele_size);
+    fix(h, h->pos[handle], handle);
+    return TRUE;
+}
+
+// Remove the element of a live handle from anywhere in the heap
+bool iheap_remove(iheap_t *h, size_t handle, void *out) {
+    if (!iheap_get(h, handle)) {
+        return FALSE;
+    }
+    if (out) {
+        memcpy(out, get_element(h, handle), h->ele_size);
+    }
+    take(h, h->pos[handle]);
+    return TRUE;
+}
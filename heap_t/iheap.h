@@ -0,0 +1,61 @@
+#ifndef _IHEAP_H_
+#define _IHEAP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "list_t.h"
+
+/*
+ * Indexed max heap. Insertion returns a handle that names the element
+ * until it is popped or removed, whatever the heap does meanwhile, so its
+ * key can be changed or the element cancelled in O(log n).
+ *
+ * Elements stay in eles at their handle and only handles move through
+ * the heap; pos maps a handle back to its heap position. heap[size..next)
+ * holds the handles that are free for reuse, so handles stay dense and
+ * nothing is allocated once the heap has reached its peak size.
+ */
+
+#define IHEAP_NONE ((size_t)-1)
+
+typedef struct iheap_struct {
+  size_t ele_size;        // Size of each element
+  bool (*gt)(void *, void *); // Greater than comparison function
+  void *eles;             // Element of each handle
+  size_t *pos;            // Heap position of each handle, IHEAP_NONE if free
+  size_t *heap;           // Handles in heap order, then free handles
+  size_t capacity;        // Handles allocated
+  size_t next;            // Handles ever handed out
+  size_t size;            // Current number of elements in the heap
+} iheap_t;
+
+// Initialize a new indexed heap
+iheap_t iheap_new(size_t ele_size, bool (*gt)(void *, void *));
+
+// Free the heap and its elements
+void iheap_free(iheap_t *h);
+
+// Insert an element (copies ele_size bytes from ele); returns its handle
+size_t iheap_insert(iheap_t *h, void *ele);
+
+// Remove the maximum element into out, and its handle into handle if not
+// NULL; returns FALSE if the heap is empty
+bool iheap_maxpop(iheap_t *h, void *out, size_t *handle);
+
+// Address of the maximum element, NULL if the heap is empty
+void *iheap_peek(iheap_t *h, size_t *handle);
+
+// Address of the element of a live handle, NULL otherwise
+void *iheap_get(iheap_t *h, size_t handle);
+
+// Replace the element of a live handle and restore heap order; returns
+// FALSE if the handle is not live
+bool iheap_update_key(iheap_t *h, size_t handle, void *ele);
+
+// Remove a live handle's element into out (may be NULL); returns FALSE if
+// the handle is not live
+bool iheap_remove(iheap_t *h, size_t handle, void *out);
+
+#endif /* _IHEAP_H_ */
@@ -0,0 +1,29 @@
+/* list_hash.h */
+
+/* Element count index shared by the list_t backends (list_t.c) */
+
+#ifndef LIST_HASH
+#define LIST_HASH
+
+#include "list_t.h"
+
+/*
+ Open addressing map from element to the number of times it is in the
+ list. Linear probing with backward shift deletion, so there are no
+ tombstones; a slot is empty when its count is 0.
+ */
+struct list_hash {
+    void **keys;
+    size_t *counts;
+    size_t cap;     /* power of two */
+    size_t used;    /* distinct elements */
+};
+
+struct list_hash *list_hash_new();
+void list_hash_free(struct list_hash *h);
+void list_hash_clear(struct list_hash *h);
+void list_hash_add(struct list_hash *h, void *x);
+void list_hash_sub(struct list_hash *h, void *x);
+size_t list_hash_count(struct list_hash *h, void *x);
+
+#endif
@@ -24,9 +24,58 @@ typedef uint64_t bool;
  List indices are of type size_t
  Success/failure returns are of type bool
  None returns are of type void
+ A list_t is a header that tracks the first and last node and the
+ length, so append, splice and length are O(1)
+ Nodes come from chunks owned by the list (a slab), freed nodes are kept
+ for reuse, and freeing a list costs one free per chunk
+ Built with -DLIST_VEC, list_t is instead a growable array of void *
+ with a gap at the last edit point (list_vec.c): indexing is O(1),
+ edits near the previous one are cheap, count and index are vector
+ scans, and splice copies l2 unless l1 is empty
  */
 
-typedef void **list_t;
+struct list_hash;
+
+#ifdef LIST_VEC
+
+typedef struct list_struct {
+    void **eles;    /* elements [0, gap) then [gap_end, cap) */
+    size_t gap;     /* first free slot, the logical edit point */
+    size_t gap_end; /* first element after the gap */
+    size_t cap;
+    struct list_hash *hash;  /* element counts, NULL unless list_hash_on */
+} *list_t;
+
+typedef struct list_cursor {
+    list_t l;
+    size_t index;   /* LEN(l) at the end */
+} list_cursor;
+
+#else
+
+typedef struct list_node {
+    void *data;
+    struct list_node *next;
+} list_node;
+
+struct list_chunk;
+
+typedef struct list_struct {
+    list_node *head;
+    list_node *tail;
+    size_t len;
+    struct list_chunk *chunks;  /* newest first, nodes are carved from it */
+    list_node *spare;           /* freed nodes, linked through next */
+    struct list_hash *hash;     /* element counts, NULL unless list_hash_on */
+} *list_t;
+
+typedef struct list_cursor {
+    list_t l;
+    list_node *prev;    /* node before the cursor, NULL at the head */
+    list_node *node;    /* node at the cursor, NULL at the end */
+} list_cursor;
+
+#endif
 
 /*
  _: New (a la Python __init__)
@@ -75,7 +124,8 @@ void list_append(list_t l, void *x);
  1: Extend
  inputs: two list_ts, l1 and l2
  outputs: nothing
- side effects: all elements of l2 are appended to l1
+ side effects: all elements of l2 are appended to l1, l2 is unchanged
+ (list_splice moves them instead, in O(1))
  example:
  list_t l1 = list_new();
  uint64_t *val = 1;
@@ -184,11 +234,23 @@ size_t list_index(list_t l, void *x);
  */
 uint64_t list_count(list_t l, void *x);
 
-/* ~: Sort
- "Extra credit" for a sorting algorithm
- More "Extra credit" for an O(n*log(n)) sort
+/*
+ ~: Sort
+ inputs: a list_t l, and a function greater_than on two elements
+ outputs: nothing
+ side effects: the elements of l are put in ascending order; equal
+ elements keep their order (stable). Bottom-up merge sort, at most about
+ n*log2(n) comparisons; the linked list relinks its own nodes and
+ allocates nothing.
+ example:
+ list_t l = list_new();
+ list_append(l, (void *)2);
+ list_append(l, (void *)1);
+ list_sort(l, greater_than);
+ list_print(l);
+ - should print "[1, 2]" if greater_than compares as integers
  */
-/* void sort(list_t l, bool (greater_than)(void *, void *)) */
+void list_sort(list_t l, bool (greater_than)(void *, void *));
 
 /*
  8: Reverse
@@ -225,4 +287,110 @@ void list_reverse(list_t l);
  */
 list_t list_copy(list_t l);
 
-#endif
\ No newline at end of file
+/*
+ 10: Length (a la Python len)
+ inputs: a list_t l
+ outputs: the number of elements in l, in O(1)
+ side effects: none
+ example:
+ list_t l = list_new();
+ list_append(l, (void *)1);
+ printf("%lu\n", list_len(l));
+ - should print "1"
+ */
+size_t list_len(list_t l);
+
+/*
+ 11: Splice
+ inputs: two list_ts, l1 and l2
+ outputs: nothing
+ side effects: the nodes of l2 are moved to the end of l1 without copying
+ (O(1) in the number of elements, l1 adopts the chunks holding them),
+ leaving l2 empty (but still to be freed)
+ example:
+ list_t l1 = list_new();
+ list_append(l1, (void *)1);
+ list_t l2 = list_new();
+ list_append(l2, (void *)2);
+ list_splice(l1, l2);
+ list_print(l1);
+ list_print(l2);
+ - should print "[1, 2]" then "[]"
+ */
+void list_splice(list_t l1, list_t l2);
+
+/*
+ 12: Hash index
+ inputs: a list_t l
+ outputs: nothing
+ side effects: l keeps a hash map from each element to its number of
+ occurrences, updated by every change to l, so list_count and
+ list_contains are O(1) expected and list_index and list_remove return
+ at once for an absent element. Splicing or extending into an indexed
+ list costs O(len(l2)). list_hash_off drops the index.
+ example:
+ list_t l = list_new();
+ list_hash_on(l);
+ list_append(l, (void *)1);
+ list_append(l, (void *)1);
+ printf("%lu\n", list_count(l, (void *)1));
+ - should print "2"
+ */
+void list_hash_on(list_t l);
+void list_hash_off(list_t l);
+
+/*
+ 13: Contains (a la Python in)
+ inputs: a list_t l, and a pointer to an memory object of any type x
+ outputs: TRUE if x is in l, FALSE otherwise
+ side effects: none
+ example:
+ list_t l = list_new();
+ list_append(l, (void *)1);
+ list_contains(l, (void *)2);
+ - should return FALSE
+ */
+bool list_contains(list_t l, void *x);
+
+/*
+ 14: Cursor
+ A list_cursor stays on an element between calls, so walking, editing
+ or erasing the whole list through one is O(n) rather than the O(n^2)
+ of indexed list_pop / list_insert calls. Any change to the list made
+ other than through the cursor invalidates it.
+ list_begin: a cursor on the first element of l
+ list_done: TRUE once the cursor is past the last element
+ list_next: move to the following element; returns !list_done
+ list_get / list_set: read or replace the element at the cursor
+ list_insert_after: insert x after the cursor, which stays where it is;
+ at the end x is appended and the cursor moves onto it
+ list_erase: remove and return the element at the cursor, which moves
+ to the following element
+ example:
+ list_t l = list_new();
+ list_append(l, (void *)1);
+ list_append(l, (void *)2);
+ list_cursor c;
+ for (c = list_begin(l); !list_done(&c); list_next(&c)) {
+     list_set(&c, (void *)((uint64_t)list_get(&c) * 10));
+ }
+ list_print(l);
+ - should print "[10, 20]"
+ */
+list_cursor list_begin(list_t l);
+bool list_done(list_cursor *c);
+bool list_next(list_cursor *c);
+void *list_get(list_cursor *c);
+void list_set(list_cursor *c, void *x);
+void list_insert_after(list_cursor *c, void *x);
+void *list_erase(list_cursor *c);
+
+/*
+ 15: For each
+ inputs: a list_t l, a function f, and a pointer arg passed through to f
+ outputs: nothing
+ side effects: f(x, arg) is called on each element x of l in order
+ */
+void list_foreach(list_t l, void (*f)(void *x, void *arg), void *arg);
+
+#endif
@@ -0,0 +1,145 @@
+#include "mqueue.h"
+
+// Helper function to pick a shard (xorshift64, per handle so no sharing)
+static size_t pick(mqueue_local *l) {
+    l->seed ^= l->seed << 13;
+    l->seed ^= l->seed >> 7;
+    l->seed ^= l->seed << 17;
+    return (size_t)(l->seed % l->q->nshards);
+}
+
+// Initialize a queue
+mqueue_t mqueue_new(size_t ele_size, bool (*gt)(void *, void *), size_t nshards) {
+    mqueue_t q;
+    void *shards;
+    size_t i;
+
+    q.ele_size = ele_size;
+    q.gt = gt;
+    q.nshards = nshards ? nshards : 1;
+    if (posix_memalign(&shards, MQ_LINE, q.nshards * sizeof(mqueue_shard))) {
+        fprintf(stderr, "Failed to allocate memory for queue\n");
+        exit(EXIT_FAILURE);
+    }
+    q.shards = shards;
+    for (i = 0; i < q.nshards; i++) {
+        pthread_mutex_init(&q.shards[i].lock, NULL);
+        q.shards[i].heap = heap_new_d(ele_size, gt, 4);
+    }
+    return q;
+}
+
+// Free the queue and its elements
+void mqueue_free(mqueue_t *q) {
+    size_t i;
+    for (i = 0; i < q->nshards; i++) {
+        pthread_mutex_destroy(&q->shards[i].lock);
+        heap_free(&q->shards[i].heap);
+    }
+    free(q->shards);
+    q->shards = NULL;
+    q->nshards = 0;
+}
+
+// Initialize a per thread handle
+mqueue_local mqueue_local_new(mqueue_t *q, uint64_t seed) {
+    mqueue_local l;
+    l.q = q;
+    l.seed = seed ? seed : 88172645463325252ULL;
+    l.count = 0;
+    l.buf = malloc(MQ_BUF * q->ele_size);
+    if (!l.buf) {
+        fprintf(stderr, "Failed to allocate memory for queue\n");
+        exit(EXIT_FAILURE);
+    }
+    return l;
+}
+
+// Flush and free a per thread handle
+void mqueue_local_free(mqueue_local *l) {
+    mqueue_flush(l);
+    free(l->buf);
+    l->buf = NULL;
+}
+
+// Push the buffer into the first random shard that is not busy, so a
+// batch costs one lock and producers spread out under contention
+void mqueue_flush(mqueue_local *l) {
+    mqueue_shard *s;
+    size_t i, tries = 0;
+
+    if (l->count == 0) {
+        return;
+    }
+    do {
+        s = &l->q->shards[pick(l)];
+    } while (pthread_mutex_trylock(&s->lock) && ++tries < l->q->nshards);
+    if (tries == l->q->nshards) {
+        pthread_mutex_lock(&s->lock);
+    }
+    for (i = 0; i < l->count; i++) {
+        heap_insert(&s->heap, (char *)l->buf + i * l->q->ele_size);
+    }
+    pthread_mutex_unlock(&s->lock);
+    l->count = 0;
+}
+
+// Insert an element through a handle
+void mqueue_insert(mqueue_local *l, void *ele) {
+    memcpy((char *)l->buf + l->count * l->q->ele_size, ele, l->q->ele_size);
+    if (++l->count == MQ_BUF) {
+        mqueue_flush(l);
+    }
+}
+
+// Remove a near maximum element: lock two random shards and pop the
+// larger top. If both are empty, sweep every shard before giving up.
+bool mqueue_pop(mqueue_local *l, void *out) {
+    mqueue_t *q = l->q;
+    mqueue_shard *lo, *hi, *best;
+    void *top, *other;
+    size_t i, j;
+
+    mqueue_flush(l);
+
+    i = pick(l);
+    j = pick(l);
+    if (i == j) {
+        j = (j + 1) % q->nshards;
+    }
+    // Lock in index order so two poppers can never deadlock
+    lo = &q->shards[i < j ? i : j];
+    hi = &q->shards[i < j ? j : i];
+    pthread_mutex_lock(&lo->lock);
+    if (hi != lo) {
+        pthread_mutex_lock(&hi->lock);
+    }
+    best = lo;
+    top = heap_peek(&lo->heap);
+    other = hi != lo ? heap_peek(&hi->heap) : NULL;
+    if (other && (!top || q->gt(other, top))) {
+        best = hi;
+        top = other;
+    }
+    if (top) {
+        heap_maxpop(&best->heap, out);
+    }
+    if (hi != lo) {
+        pthread_mutex_unlock(&hi->lock);
+    }
+    pthread_mutex_unlock(&lo->lock);
+    if (top) {
+        return TRUE;
+    }
+
+    for (i = 0; i < q->nshards; i++) {
+        lo = &q->shards[i];
+        pthread_mutex_lock(&lo->lock);
+        if (heap_maxpop(&lo->heap, out)) {
+            pthread_mutex_unlock(&lo->lock);
+            return TRUE;
+        }
+        pthread_mutex_unlock(&lo->lock);
+    }
+    return FALSE;
+}
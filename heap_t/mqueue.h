@@ -0,0 +1,64 @@
+#ifndef _MQUEUE_H_
+#define _MQUEUE_H_
+
+#include <pthread.h>
+#include "heap_t.h"
+
+/*
+ * Relaxed concurrent priority queue (MultiQueue). Elements are spread
+ * over nshards heap_t shards, each behind its own mutex. A pop locks two
+ * random shards and takes the larger top, so it returns one of the
+ * largest elements rather than always the largest; with c shards per
+ * thread the expected rank of a pop is O(c * threads).
+ *
+ * Each thread works through its own mqueue_local, which buffers inserts
+ * and pushes them into one shard per MQ_BUF elements. Buffered elements
+ * are not visible to other threads until that thread flushes (any pop on
+ * the same handle flushes first).
+ */
+
+#define MQ_BUF 16
+#define MQ_LINE 64  // Cache line size shards are aligned to
+
+typedef struct mqueue_shard {
+  pthread_mutex_t lock;
+  heap_t heap;
+} __attribute__((aligned(MQ_LINE))) mqueue_shard;
+
+typedef struct mqueue_struct {
+  size_t ele_size;            // Size of each element
+  bool (*gt)(void *, void *); // Greater than comparison function
+  size_t nshards;             // Number of shards
+  mqueue_shard *shards;       // Cache line aligned shards
+} mqueue_t;
+
+typedef struct mqueue_local_struct {
+  mqueue_t *q;                // Queue this handle feeds
+  uint64_t seed;              // Per thread shard chooser state
+  size_t count;               // Buffered inserts
+  void *buf;                  // Room for MQ_BUF elements
+} mqueue_local;
+
+// Initialize a queue; 2 to 4 shards per thread is a good choice
+mqueue_t mqueue_new(size_t ele_size, bool (*gt)(void *, void *), size_t nshards);
+
+// Free the queue and its elements (no thread may be using it)
+void mqueue_free(mqueue_t *q);
+
+// Initialize a per thread handle; seed should differ between threads
+mqueue_local mqueue_local_new(mqueue_t *q, uint64_t seed);
+
+// Flush and free a per thread handle
+void mqueue_local_free(mqueue_local *l);
+
+// Insert an element (copies ele_size bytes from ele) through a handle
+void mqueue_insert(mqueue_local *l, void *ele);
+
+// Push any buffered inserts into the shared shards
+void mqueue_flush(mqueue_local *l);
+
+// Remove a near maximum element into out; returns FALSE only if every
+// shard was empty when checked
+bool mqueue_pop(mqueue_local *l, void *out);
+
+#endif /* _MQUEUE_H_ */
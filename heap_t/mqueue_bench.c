@@ -0,0 +1,142 @@
+/* mqueue_bench.c - MultiQueue throughput against one locked heap_t */
+
+/*
+ * gcc -O2 mqueue_bench.c mqueue.c heap_t.c sort.c list_t.c -pthread -o mqueue_bench
+ *
+ * The queue is prefilled with PREFILL random uint64 keys, then every
+ * thread runs OPS operations alternating insert and pop (a producer and
+ * consumer in one). Reports total Mops/s for 1, 2, 4 ... MAX_THREADS
+ * threads. The queue uses 4 shards per thread. The baseline is a single
+ * heap_t behind one mutex. Every key popped or left behind is counted, so
+ * a lost or duplicated element shows up as a failed check.
+ */
+
+#include <time.h>
+#include "mqueue.h"
+
+#define PREFILL 1000000
+#define OPS 2000000
+#define MAX_THREADS 16
+
+typedef struct bench_arg {
+    mqueue_t *q;                // NULL for the locked baseline
+    heap_t *h;
+    pthread_mutex_t *lock;
+    uint64_t seed;
+    uint64_t pushed, popped;    // sums of keys, for the check
+} bench_arg;
+
+static bool u64_gt(void *a, void *b) {
+    return *(uint64_t *)a > *(uint64_t *)b;
+}
+
+static uint64_t rnd(uint64_t *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *run_mqueue(void *p) {
+    bench_arg *a = p;
+    mqueue_local l = mqueue_local_new(a->q, a->seed);
+    uint64_t x;
+    size_t i;
+
+    for (i = 0; i < OPS / 2; i++) {
+        x = rnd(&a->seed) >> 1;
+        mqueue_insert(&l, &x);
+        a->pushed += x;
+        if (mqueue_pop(&l, &x)) {
+            a->popped += x;
+        }
+    }
+    mqueue_local_free(&l);
+    return NULL;
+}
+
+static void *run_locked(void *p) {
+    bench_arg *a = p;
+    uint64_t x;
+    size_t i;
+
+    for (i = 0; i < OPS / 2; i++) {
+        x = rnd(&a->seed) >> 1;
+        pthread_mutex_lock(a->lock);
+        heap_insert(a->h, &x);
+        pthread_mutex_unlock(a->lock);
+        a->pushed += x;
+        pthread_mutex_lock(a->lock);
+        if (heap_maxpop(a->h, &x)) {
+            a->popped += x;
+        }
+        pthread_mutex_unlock(a->lock);
+    }
+    return NULL;
+}
+
+// Run one configuration; returns Mops/s, or -1 if the check failed
+static double run(int sharded, size_t nthreads) {
+    pthread_t threads[MAX_THREADS];
+    bench_arg args[MAX_THREADS];
+    pthread_mutex_t lock;
+    heap_t h = heap_new_d(sizeof(uint64_t), u64_gt, 4);
+    mqueue_t q = mqueue_new(sizeof(uint64_t), u64_gt, 4 * nthreads);
+    mqueue_local l = mqueue_local_new(&q, 1);
+    uint64_t seed = 88172645463325252ULL, x, pushed = 0, popped = 0;
+    double start, secs;
+    size_t i;
+
+    pthread_mutex_init(&lock, NULL);
+    for (i = 0; i < PREFILL; i++) {
+        x = rnd(&seed) >> 1;
+        pushed += x;
+        if (sharded) {
+            mqueue_insert(&l, &x);
+        } else {
+            heap_insert(&h, &x);
+        }
+    }
+    mqueue_flush(&l);
+
+    start = now();
+    for (i = 0; i < nthreads; i++) {
+        args[i].q = sharded ? &q : NULL;
+        args[i].h = &h;
+        args[i].lock = &lock;
+        args[i].seed = 0x9e3779b97f4a7c15ULL * (i + 1);
+        args[i].pushed = args[i].popped = 0;
+        pthread_create(&threads[i], NULL, sharded ? run_mqueue : run_locked, &args[i]);
+    }
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+        pushed += args[i].pushed;
+        popped += args[i].popped;
+    }
+    secs = now() - start;
+
+    while (sharded ? mqueue_pop(&l, &x) : heap_maxpop(&h, &x)) {
+        popped += x;
+    }
+    mqueue_local_free(&l);
+    mqueue_free(&q);
+    heap_free(&h);
+    pthread_mutex_destroy(&lock);
+    return pushed == popped ? (double)(OPS * nthreads) / secs / 1e6 : -1;
+}
+
+int main(void) {
+    size_t t;
+
+    printf("%8s %12s %12s   (Mops/s, alternating insert and pop)\n", "threads", "locked", "mqueue");
+    for (t = 1; t <= MAX_THREADS; t *= 2) {
+        printf("%8lu %12.2f %12.2f\n", t, run(0, t), run(1, t));
+    }
+    return 0;
+}
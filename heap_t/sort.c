@@ -0,0 +1,159 @@
+#include "sort.h"
+
+// Runs this short are left for the final insertion sort
+#define SHORT 16
+
+// Helper function to get the address of element i
+#define AT(base, i, size) ((char *)(base) + (i) * (size))
+
+// Helper function to swap two elements, 64 bytes at a time
+static void swap(void *a, void *b, size_t size) {
+    char tmp[64], *x = a, *y = b;
+    size_t n;
+    while (size) {
+        n = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, x, n);
+        memcpy(x, y, n);
+        memcpy(y, tmp, n);
+        x += n;
+        y += n;
+        size -= n;
+    }
+}
+
+// Heapsort fallback for partitions that keep splitting badly
+static void heap_sort(void *base, size_t count, size_t size, bool (*gt)(void *, void *)) {
+    size_t i, end, root, child;
+    for (end = count, i = count / 2; end > 1;) {
+        if (i > 0) {
+            root = --i;          // Building the heap
+        } else {
+            swap(base, AT(base, --end, size), size);
+            root = 0;            // Moving the max behind the heap
+        }
+        while ((child = 2 * root + 1) < end) {
+            if (child + 1 < end && gt(AT(base, child + 1, size), AT(base, child, size))) {
+                child++;
+            }
+            if (!gt(AT(base, child, size), AT(base, root, size))) {
+                break;
+            }
+            swap(AT(base, root, size), AT(base, child, size), size);
+            root = child;
+        }
+    }
+}
+
+// Helper function to order a, b, c so that a <= b <= c
+static void sort3(void *a, void *b, void *c, size_t size, bool (*gt)(void *, void *)) {
+    if (gt(a, b)) {
+        swap(a, b, size);
+    }
+    if (gt(b, c)) {
+        swap(b, c, size);
+        if (gt(a, b)) {
+            swap(a, b, size);
+        }
+    }
+}
+
+// Quicksort down to SHORT element runs, recursing on the smaller side
+static void intro_sort(char *base, size_t count, size_t size, bool (*gt)(void *, void *), size_t depth) {
+    size_t i, j;
+    while (count > SHORT) {
+        if (depth-- == 0) {
+            heap_sort(base, count, size, gt);
+            return;
+        }
+
+        // Median of three goes to the front as the pivot; the first and
+        // last elements then stop both scans without bounds checks
+        sort3(base, AT(base, count / 2, size), AT(base, count - 1, size), size, gt);
+        swap(base, AT(base, count / 2, size), size);
+        i = 0;
+        j = count;
+        for (;;) {
+            while (gt(base, AT(base, ++i, size))) { }
+            while (gt(AT(base, --j, size), base)) { }
+            if (i >= j) {
+                break;
+            }
+            swap(AT(base, i, size), AT(base, j, size), size);
+        }
+        swap(base, AT(base, j, size), size);
+
+        if (j < count - j - 1) {
+            intro_sort(base, j, size, gt, depth);
+            base = AT(base, j + 1, size);
+            count -= j + 1;
+        } else {
+            intro_sort(AT(base, j + 1, size), count - j - 1, size, gt, depth);
+            count = j;
+        }
+    }
+}
+
+// Sort an array in place
+void sort_array(void *base, size_t count, size_t ele_size, bool (*gt)(void *, void *)) {
+    size_t depth = 0, n, i, j;
+    if (count < 2) {
+        return;
+    }
+    for (n = count; n > 1; n >>= 1) {
+        depth += 2;
+    }
+    intro_sort(base, count, ele_size, gt, depth);
+
+    // Every element is now within SHORT places of home
+    for (i = 1; i < count; i++) {
+        for (j = i; j > 0 && gt(AT(base, j - 1, ele_size), AT(base, j, ele_size)); j--) {
+            swap(AT(base, j - 1, ele_size), AT(base, j, ele_size), ele_size);
+        }
+    }
+}
+
+// Sort keys in place, ping-ponging through one buffer
+void radix_sort_u64(uint64_t *keys, size_t count) {
+    size_t counts[8][256] = {{0}};
+    uint64_t *src = keys, *dst, *tmp;
+    size_t i, b, sum, c;
+
+    if (count < 2) {
+        return;
+    }
+    tmp = malloc(count * sizeof(uint64_t));
+    if (tmp == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    dst = tmp;
+
+    // One pass counts every byte position
+    for (i = 0; i < count; i++) {
+        for (b = 0; b < 8; b++) {
+            counts[b][(keys[i] >> (8 * b)) & 0xff]++;
+        }
+    }
+
+    for (b = 0; b < 8; b++) {
+        if (counts[b][(keys[0] >> (8 * b)) & 0xff] == count) {
+            continue;  // Every key has the same byte here
+        }
+        for (sum = 0, i = 0; i < 256; i++) {
+            c = counts[b][i];
+            counts[b][i] = sum;
+            sum += c;
+        }
+        for (i = 0; i < count; i++) {
+            dst[counts[b][(src[i] >> (8 * b)) & 0xff]++] = src[i];
+        }
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != keys) {
+        memcpy(keys, src, count * sizeof(uint64_t));
+    }
+    free(src == keys ? dst : src);
+}
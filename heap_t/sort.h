@@ -0,0 +1,20 @@
+#ifndef _SORT_H_
+#define _SORT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "list_t.h"
+
+// Sort count elements of ele_size bytes at base into ascending order, in
+// place. gt(a, b) gets two element addresses, as for heap_t. Introsort:
+// median of three quicksort, heapsort once the depth passes 2 log2(n),
+// insertion sort for short runs. O(n log n) worst case, not stable.
+void sort_array(void *base, size_t count, size_t ele_size, bool (*gt)(void *, void *));
+
+// Sort count keys into ascending order. LSD radix sort on bytes, skipping
+// bytes that are equal in every key; uses one count-sized buffer.
+void radix_sort_u64(uint64_t *keys, size_t count);
+
+#endif /* _SORT_H_ */
@@ -4,9 +4,22 @@
 
 #include "list_t.h"
 
+bool greater_than(void *a, void *b)
+{
+    return (uint64_t)a > (uint64_t)b;
+}
+
+void add_to(void *x, void *sum)
+{
+    *(uint64_t *)sum += (uint64_t)x;
+}
+
 int main()
 {
     list_t l = list_new(), l2;
+    list_cursor c;
+    uint64_t sum = 0, i;
+    int ok = 1;
 
     /* Test new and print */
 
@@ -122,5 +135,102 @@ int main()
     list_clear(l);
     list_print(l2);
 
+    /* Test length and splice */
+
+    printf("\n10. Splice\n");
+    printf("Splicing [3,1,3,1,1] onto [7], then lengths, should be:\n");
+    printf("[7, 3, 1, 3, 1, 1]\n");
+    printf("[]\n");
+    printf("6 0\n");
+    printf("Is found to be:\n");
+    list_append(l,(void *)7);
+    list_splice(l, l2);
+    list_print(l);
+    list_print(l2);
+    printf("%lu %lu\n", list_len(l), list_len(l2));
+
+    /* Test sort */
+
+    printf("\n11. Sort\n");
+    printf("Sorting [7,3,1,3,1,1] should be:\n");
+    printf("[1, 1, 1, 3, 3, 7]\n");
+    printf("Is found to be:\n");
+    list_sort(l, greater_than);
+    list_print(l);
+
+    /* Test cursor */
+
+    printf("\n12. Cursor\n");
+    printf("Erasing the 1s, putting 4 after each 3 and 8 after 7, then summing, should be:\n");
+    printf("[3, 4, 3, 4, 7, 8]\n");
+    printf("29\n");
+    printf("Is found to be:\n");
+    for (c = list_begin(l); !list_done(&c);) {
+        if (list_get(&c) == (void *)1) {
+            list_erase(&c);
+            continue;
+        }
+        list_insert_after(&c, (void *)(uint64_t)(list_get(&c) == (void *)3 ? 4 : 8));
+        list_next(&c);
+        list_next(&c);
+    }
+    list_print(l);
+    list_foreach(l, add_to, &sum);
+    printf("%lu\n", sum);
+
+    /* Test hash index */
+
+    printf("\n13. Hash index\n");
+    printf("Indexing [1,2,1] midway, appending 1 and 2, then count of 1, should be:\n");
+    printf("3\n");
+    printf("Popping index 0 and removing 1 twice, then count and contains of 1,\n");
+    printf("contains and index of 2, should be:\n");
+    printf("[2, 2]\n");
+    printf("0 0 1 0\n");
+    printf("Adding 100..299 (shifted to collide), removing the odd ones, all counts right, should be:\n");
+    printf("1\n");
+    printf("Splicing in [3,4,3,4,7,8], counts of 3 and 8, should be:\n");
+    printf("2 1\n");
+    printf("Clearing, count of 3, contains of 2, length, then count of 3 appended, should be:\n");
+    printf("0 0 0 1\n");
+    printf("Is found to be:\n");
+    list_append(l2, (void *)1);
+    list_append(l2, (void *)2);
+    list_append(l2, (void *)1);
+    list_hash_on(l2);
+    list_append(l2, (void *)1);
+    list_append(l2, (void *)2);
+    printf("%lu\n", list_count(l2, (void *)1));
+    list_pop(l2, 0);
+    list_remove(l2, (void *)1);
+    list_remove(l2, (void *)1);
+    list_print(l2);
+    printf("%lu %lu %lu %lu\n", list_count(l2, (void *)1), list_contains(l2, (void *)1),
+           list_contains(l2, (void *)2), list_index(l2, (void *)2));
+
+    /*
+     Enough elements to grow the table; i << 40 all hash to one of two
+     slots, so every removal leaves a hole in a long probe run
+     */
+    for (i = 100; i < 300; i++) {
+        list_append(l2, (void *)(i << 40));
+    }
+    for (i = 101; i < 300; i += 2) {
+        ok &= list_remove(l2, (void *)(i << 40)) == TRUE;
+    }
+    for (i = 100; i < 300; i++) {
+        ok &= list_count(l2, (void *)(i << 40)) == (i % 2 ? 0 : 1)
+              && list_contains(l2, (void *)(i << 40)) == (i % 2 ? FALSE : TRUE);
+    }
+    ok &= list_count(l2, (void *)2) == 2 && list_len(l2) == 102;
+    printf("%d\n", ok);
+
+    list_splice(l2, l);
+    printf("%lu %lu\n", list_count(l2, (void *)3), list_count(l2, (void *)8));
+    list_clear(l2);
+    printf("%lu %lu %lu ", list_count(l2, (void *)3), list_contains(l2, (void *)2), list_len(l2));
+    list_append(l2, (void *)3);
+    printf("%lu\n", list_count(l2, (void *)3));
+
     return 0;
 }
\ No newline at end of file
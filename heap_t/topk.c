@@ -0,0 +1,90 @@
+#include "topk.h"
+
+#define PARENT(i) (((i) - 1) / 2)
+#define CHILD(i) (2 * (i) + 1)
+
+// Helper function to get the address of an element at a given index
+static void *get_element(topk_t *t, size_t index) {
+    return (char *)t->eles + index * t->ele_size;
+}
+
+// Sift ele up from the hole at index, moving each greater parent down
+static void heapify_up(topk_t *t, size_t index, void *ele) {
+    while (index > 0 && t->gt(get_element(t, PARENT(index)), ele)) {
+        memcpy(get_element(t, index), get_element(t, PARENT(index)), t->ele_size);
+        index = PARENT(index);
+    }
+    memcpy(get_element(t, index), ele, t->ele_size);
+}
+
+// Sift ele down from the hole at index, moving the lesser child up while
+// ele beats it. ele must not live inside the heap.
+static void heapify_down(topk_t *t, size_t index, void *ele) {
+    size_t child;
+    while ((child = CHILD(index)) < t->size) {
+        if (child + 1 < t->size && t->gt(get_element(t, child), get_element(t, child + 1))) {
+            child++;
+        }
+        if (!t->gt(ele, get_element(t, child))) {
+            break;
+        }
+        memcpy(get_element(t, index), get_element(t, child), t->ele_size);
+        index = child;
+    }
+    memcpy(get_element(t, index), ele, t->ele_size);
+}
+
+// Initialize a selector for the k greatest elements
+topk_t topk_new(size_t ele_size, bool (*gt)(void *, void *), size_t k) {
+    topk_t t;
+    t.ele_size = ele_size;
+    t.gt = gt;
+    t.k = k;
+    t.size = 0;
+    t.eles = malloc((k ? k : 1) * ele_size);
+    if (t.eles == NULL) {
+        fprintf(stderr, "Failed to allocate memory for top-k\n");
+        exit(EXIT_FAILURE);
+    }
+    return t;
+}
+
+// Free the selector and its elements
+void topk_free(topk_t *t) {
+    free(t->eles);
+    t->eles = NULL;
+    t->size = t->k = 0;
+}
+
+// Offer an element; once full it must beat the weakest kept element
+bool topk_push(topk_t *t, void *ele) {
+    if (t->size < t->k) {
+        t->size++;
+        heapify_up(t, t->size - 1, ele);
+        return TRUE;
+    }
+    if (t->k == 0 || !t->gt(ele, get_element(t, 0))) {
+        return FALSE;
+    }
+    heapify_down(t, 0, ele);
+    return TRUE;
+}
+
+// Address of the weakest kept element
+void *topk_min(topk_t *t) {
+    return t->size ? get_element(t, 0) : NULL;
+}
+
+// Pop the weakest into the back of out until empty, so out ends up
+// greatest first
+size_t topk_drain(topk_t *t, void *out) {
+    size_t n = t->size;
+    while (t->size > 0) {
+        t->size--;
+        memcpy((char *)out + t->size * t->ele_size, get_element(t, 0), t->ele_size);
+        if (t->size > 0) {
+            heapify_down(t, 0, get_element(t, t->size));
+        }
+    }
+    return n;
+}
@@ -0,0 +1,41 @@
+#ifndef _TOPK_H_
+#define _TOPK_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "list_t.h"
+
+/*
+ * Bounded top-k selection: keeps the k greatest elements seen so far in a
+ * min-heap of exactly k slots, allocated once. The root is the weakest
+ * kept element, so a stream element that does not beat it is rejected
+ * with a single comparison and one that does replaces it with one sift.
+ */
+
+typedef struct topk_struct {
+  size_t ele_size;        // Size of each element
+  bool (*gt)(void *, void *); // Greater than comparison function
+  void *eles;             // k slots, a min-heap on gt
+  size_t k;               // Capacity, fixed
+  size_t size;            // Elements kept so far (at most k)
+} topk_t;
+
+// Initialize a selector for the k greatest elements
+topk_t topk_new(size_t ele_size, bool (*gt)(void *, void *), size_t k);
+
+// Free the selector and its elements
+void topk_free(topk_t *t);
+
+// Offer an element (copies ele_size bytes); returns TRUE if it was kept
+bool topk_push(topk_t *t, void *ele);
+
+// Address of the weakest kept element, NULL if none are kept
+void *topk_min(topk_t *t);
+
+// Move the kept elements into out, greatest first, and empty the
+// selector; returns how many were written
+size_t topk_drain(topk_t *t, void *out);
+
+#endif /* _TOPK_H_ */
@@ -0,0 +1,156 @@
+/* hexinc.c - table and SSSE3 hex codec, no stdio anywhere */
+
+#include "hexinc.h"
+#include <string.h>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+static const char digits[16] = "0123456789abcdef";
+
+/* value + 1 of each hex char, 0 marks a non-hex char */
+static const uint8_t unhex[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+/* limbs converted per pass in the bignum routines */
+#define CHUNK 32
+
+void hex_encode(const uint8_t *in, size_t len, char *out) {
+    size_t i = 0;
+#ifdef __SSSE3__
+    const __m128i table = _mm_loadu_si128((const __m128i *)digits);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; i < len; i++) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0f];
+    }
+}
+
+int hex_decode(const char *in, size_t len, uint8_t *out) {
+    size_t i = 0;
+    if (len & 1) {
+        return -1;
+    }
+#ifdef __SSSE3__
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i five = _mm_set1_epi8(5);
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i alpha = _mm_set1_epi8('a' - 10);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i weights = _mm_set1_epi16(0x0110); /* 16 * even + 1 * odd */
+    for (; i + 32 <= len; i += 32) {
+        __m128i half[2];
+        int k;
+        for (k = 0; k < 2; k++) {
+            __m128i c = _mm_loadu_si128((const __m128i *)(in + i + 16 * k));
+            __m128i d = _mm_sub_epi8(c, zero);
+            __m128i a = _mm_sub_epi8(_mm_or_si128(c, lower), alpha);
+            __m128i a0 = _mm_sub_epi8(a, ten);
+            __m128i isd = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+            __m128i isa = _mm_cmpeq_epi8(_mm_min_epu8(a0, five), a0);
+            if (_mm_movemask_epi8(_mm_or_si128(isd, isa)) != 0xffff) {
+                return -1;
+            }
+            half[k] = _mm_maddubs_epi16(_mm_or_si128(_mm_and_si128(isd, d),
+                                                     _mm_and_si128(isa, a)),
+                                        weights);
+        }
+        _mm_storeu_si128((__m128i *)(out + i / 2), _mm_packus_epi16(half[0], half[1]));
+    }
+#endif
+    for (; i < len; i += 2) {
+        uint8_t hi = unhex[(uint8_t)in[i]], lo = unhex[(uint8_t)in[i + 1]];
+        if (!hi || !lo) {
+            return -1;
+        }
+        out[i / 2] = (uint8_t)(((hi - 1) << 4) | (lo - 1));
+    }
+    return 0;
+}
+
+size_t hex_span(const char *s, size_t len) {
+    size_t i = 0;
+    while (i < len && unhex[(uint8_t)s[i]]) {
+        i++;
+    }
+    return i;
+}
+
+void hex_digest(const uint8_t *digest, size_t len, char *out) {
+    hex_encode(digest, len, out);
+    out[2 * len] = 0;
+}
+
+size_t big_to_hex(const uint64_t *a, size_t words, char *out) {
+    uint8_t be[CHUNK * 8];
+    size_t top = words, i, k, n = 0;
+
+    while (top > 1 && !a[top - 1]) {
+        top--;
+    }
+    /* limbs top-1 .. 0 become one big-endian byte string, CHUNK at a time */
+    for (i = top; i > 0; i -= k) {
+        k = i < CHUNK ? i : CHUNK;
+        for (size_t j = 0; j < k; j++) {
+            uint64_t w = __builtin_bswap64(a[i - 1 - j]);
+            memcpy(be + 8 * j, &w, 8);
+        }
+        hex_encode(be, 8 * k, out + n);
+        n += 16 * k;
+    }
+    out[n] = 0;
+    return n;
+}
+
+int hex_to_big(const char *h, size_t len, uint64_t *n, size_t words) {
+    uint8_t be[CHUNK * 8];
+    size_t head, limbs, i, k;
+
+    memset(n, 0, words * sizeof(uint64_t));
+    while (len > 0 && *h == '0') {
+        h++;
+        len--;
+    }
+    head = len % 16;
+    limbs = len / 16;
+    if (limbs + (head != 0) > words) {
+        return -1;
+    }
+    /* the short most significant limb, if any */
+    for (i = 0; i < head; i++) {
+        uint8_t v = unhex[(uint8_t)h[i]];
+        if (!v) {
+            return -1;
+        }
+        n[limbs] = (n[limbs] << 4) | (uint64_t)(v - 1);
+    }
+    h += head;
+    /* then whole limbs, most significant first */
+    for (i = limbs; i > 0; i -= k) {
+        k = i < CHUNK ? i : CHUNK;
+        if (hex_decode(h, 16 * k, be)) {
+            return -1;
+        }
+        for (size_t j = 0; j < k; j++) {
+            uint64_t w;
+            memcpy(&w, be + 8 * j, 8);
+            n[i - 1 - j] = __builtin_bswap64(w);
+        }
+        h += 16 * k;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+/* hexinc.h */
+
+/* bulk hex <-> binary conversion for bignums, keys and digests */
+
+#ifndef HEXINC_H
+#define HEXINC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* bytes -> lowercase hex, writes exactly 2 * len chars (no terminator) */
+void hex_encode(const uint8_t *in, size_t len, char *out);
+
+/* hex -> bytes, len must be even; returns 0, or -1 on a non-hex char */
+int hex_decode(const char *in, size_t len, uint8_t *out);
+
+/* number of leading hex digits in the first len chars of s */
+size_t hex_span(const char *s, size_t len);
+
+/* digest -> 2 * len hex chars plus a terminator, as stored in Block.hash */
+void hex_digest(const uint8_t *digest, size_t len, char *out);
+
+/*
+ big -> hex, most significant limb first, 16 digits per limb and leading
+ zero limbs dropped (the unsafe.pub line format). out needs 16 * words + 1
+ chars. Returns the number of digits written, out is terminated.
+ */
+size_t big_to_hex(const uint64_t *a, size_t words, char *out);
+
+/*
+ hex -> big, right aligned into words little-endian limbs (upper limbs
+ zeroed). Returns 0, or -1 on a non-hex char or a value too wide for words.
+ */
+int hex_to_big(const char *h, size_t len, uint64_t *n, size_t words);
+
+#endif /* HEXINC_H */
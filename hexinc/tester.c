@@ -0,0 +1,88 @@
+/* tester.c */
+
+/* tests hexinc.c functionality */
+
+#include <stdio.h>
+#include <string.h>
+#include "hexinc.h"
+
+int main()
+{
+    uint8_t bytes[64], back[64];
+    uint64_t big[64], big2[64];
+    char text[64 * 16 + 1];
+    int i, ok;
+
+    /* Test encode */
+
+    printf("\n0. Encode\n");
+    printf("Encoding 00 01 .. 3f should print:\n");
+    printf("000102030405060708090a0b0c0d0e0f...3c3d3e3f\n");
+    printf("Does print:\n");
+    for (i = 0; i < 64; i++) {
+        bytes[i] = (uint8_t)i;
+    }
+    hex_digest(bytes, 64, text);
+    printf("%.32s...%s\n", text, text + 120);
+
+    /* Test decode */
+
+    printf("\n1. Decode\n");
+    printf("Decoding that (upper case) back should print:\n");
+    printf("1\n");
+    printf("Does print:\n");
+    for (i = 0; i < 128; i++) {
+        if (text[i] >= 'a') {
+            text[i] -= 0x20;
+        }
+    }
+    ok = !hex_decode(text, 128, back) && !memcmp(bytes, back, 64);
+    printf("%d\n", ok);
+
+    /* Test bad input */
+
+    printf("\n2. Reject\n");
+    printf("Decoding \"0g\", \"abc\" and a bad char at 40 should print:\n");
+    printf("-1 -1 -1\n");
+    printf("Does print:\n");
+    text[40] = 'x';
+    printf("%d %d %d\n", hex_decode("0g", 2, back), hex_decode("abc", 3, back),
+           hex_decode(text, 128, back));
+
+    /* Test span */
+
+    printf("\n3. Span\n");
+    printf("Hex span of \"10001\\n\" should be:\n");
+    printf("5\n");
+    printf("Is found to be:\n");
+    printf("%lu\n", hex_span("10001\n", 6));
+
+    /* Test big round trip */
+
+    printf("\n4. Big\n");
+    printf("Parsing \"1\" + 40 zeros and formatting it should print:\n");
+    printf("000000010000000000000000000000000000000000000000\n");
+    printf("Does print:\n");
+    hex_to_big("10000000000000000000000000000000000000000", 41, big, 64);
+    big_to_hex(big, 64, text);
+    printf("%s\n", text);
+
+    printf("\n5. Big round trip\n");
+    printf("Formatting and parsing a full 4096 bit value should print:\n");
+    printf("1024 1\n");
+    printf("Does print:\n");
+    for (i = 0; i < 64; i++) {
+        big[i] = 0x0123456789abcdefULL * (uint64_t)(i + 1);
+    }
+    i = (int)big_to_hex(big, 64, text);
+    ok = !hex_to_big(text, (size_t)i, big2, 64) && !memcmp(big, big2, sizeof(big));
+    printf("%d %d\n", i, ok);
+
+    printf("\n6. Big overflow\n");
+    printf("Parsing 17 digits into one limb should print:\n");
+    printf("-1\n");
+    printf("Does print:\n");
+    printf("%d\n", hex_to_big("10000000000000000", 17, big, 1));
+
+    return 0;
+}
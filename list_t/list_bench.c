@@ -0,0 +1,182 @@
+/* list_bench.c - list_t against a plain malloc-per-node chain */
+
+/*
+ * gcc -O2 list_bench.c list_t.c list_vec.c plist.c -o list_bench
+ * gcc -O2 -mavx2 -DLIST_VEC list_bench.c list_t.c list_vec.c plist.c -o list_bench
+ *
+ * For each size n: build by appending n elements, walk the list once
+ * summing elements through a cursor, then free it. The baseline
+ * chain allocates each node with its own malloc, as list_t used to. Then
+ * list_count and list_index of the last element. Reports ns per element.
+ *
+ * Then, for lists of n elements drawn from n / 4 distinct values, LOOKUPS
+ * list_count and list_contains (of absent values) calls, linear scan
+ * against list_hash_on. Reports ns per call.
+ *
+ * Last, SNAPS snapshots of an n element list, each followed by a change
+ * to one element among the first FRONT: list_copy against plist_copy
+ * and plist_set. Reports ns per snapshot and the KiB of nodes the
+ * snapshots keep (for plist, the nodes each set copied).
+ */
+
+#include <time.h>
+#include "plist.h"
+
+#define LOOKUPS 1000
+#define SNAPS 100
+#define FRONT 16
+
+/* Bytes per element of a list_copy */
+#ifdef LIST_VEC
+#define LIST_ELE sizeof(void *)
+#else
+#define LIST_ELE sizeof(list_node)
+#endif
+
+typedef struct chain {
+    void *data;
+    struct chain *next;
+} chain;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    size_t n, i;
+    uint64_t sink = 0;
+    double t[8], start;
+
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s   (ns per element)\n", "n",
+           "build", "walk", "free", "malloc bld", "walk", "free", "count", "index");
+    for (n = 1000; n <= 10000000; n *= 10) {
+        list_t l = list_new();
+        list_cursor cur;
+        chain *head = NULL, *tail = NULL, *c, *next;
+
+        start = now();
+        for (i = 0; i < n; i++) {
+            list_append(l, (void *)i);
+        }
+        t[0] = now() - start;
+        start = now();
+        for (cur = list_begin(l); !list_done(&cur); list_next(&cur)) {
+            sink += (uint64_t)list_get(&cur);
+        }
+        t[1] = now() - start;
+        start = now();
+        sink += list_count(l, (void *)7);
+        t[6] = now() - start;
+        start = now();
+        sink += list_index(l, (void *)(n - 1));
+        t[7] = now() - start;
+        start = now();
+        list_free(l);
+        t[2] = now() - start;
+
+        start = now();
+        for (i = 0; i < n; i++) {
+            c = malloc(sizeof(chain));
+            c->data = (void *)i;
+            c->next = NULL;
+            if (tail == NULL) {
+                head = c;
+            } else {
+                tail->next = c;
+            }
+            tail = c;
+        }
+        t[3] = now() - start;
+        start = now();
+        for (c = head; c != NULL; c = c->next) {
+            sink += (uint64_t)c->data;
+        }
+        t[4] = now() - start;
+        start = now();
+        for (c = head; c != NULL; c = next) {
+            next = c->next;
+            free(c);
+        }
+        t[5] = now() - start;
+
+        printf("%10lu", n);
+        for (i = 0; i < 8; i++) {
+            printf(" %10.2f", t[i] / (double)n);
+        }
+        printf("\n");
+    }
+
+    printf("\n%10s %10s %10s %10s %10s   (ns per call)\n", "n",
+           "count", "contains", "hash count", "contains");
+    for (n = 1000; n <= 1000000; n *= 10) {
+        list_t l = list_new();
+        int hashed;
+
+        for (i = 0; i < n; i++) {
+            list_append(l, (void *)(i % (n / 4) + 1));
+        }
+        printf("%10lu", n);
+        for (hashed = 0; hashed < 2; hashed++) {
+            if (hashed) {
+                list_hash_on(l);
+            }
+            start = now();
+            for (i = 0; i < LOOKUPS; i++) {
+                sink += list_count(l, (void *)(i % (n / 4) + 1));
+            }
+            t[0] = now() - start;
+            start = now();
+            for (i = 0; i < LOOKUPS; i++) {
+                sink += list_contains(l, (void *)(n + i));
+            }
+            t[1] = now() - start;
+            printf(" %10.1f %10.1f", t[0] / LOOKUPS, t[1] / LOOKUPS);
+        }
+        printf("\n");
+        list_free(l);
+    }
+
+    printf("\n%10s %10s %10s %10s %10s   (ns per snapshot, KiB kept)\n", "n",
+           "list_copy", "KiB", "plist_copy", "KiB");
+    for (n = 1000; n <= 100000; n *= 10) {
+        list_t l = list_new(), *ls = malloc(SNAPS * sizeof(list_t));
+        plist_t p, *ps = malloc(SNAPS * sizeof(plist_t));
+        size_t s, kept = 0;
+
+        for (i = 0; i < n; i++) {
+            list_append(l, (void *)i);
+        }
+        p = plist_from_list(l);
+        start = now();
+        for (s = 0; s < SNAPS; s++) {
+            ls[s] = list_copy(l);
+            list_pop(l, s % FRONT);
+            list_insert(l, s % FRONT, (void *)s);
+        }
+        t[0] = now() - start;
+        start = now();
+        for (s = 0; s < SNAPS; s++) {
+            ps[s] = plist_copy(p);
+            plist_set(p, s % FRONT, (void *)s);
+
+            /* The set copied the shared nodes up to and including its index */
+            kept += s % FRONT + 1;
+        }
+        t[1] = now() - start;
+        printf("%10lu %10.1f %10lu %10.1f %10lu\n", n,
+               t[0] / SNAPS, SNAPS * n * LIST_ELE / 1024,
+               t[1] / SNAPS, (n + kept) * sizeof(plist_node) / 1024);
+        for (s = 0; s < SNAPS; s++) {
+            sink += list_len(ls[s]) + plist_len(ps[s]);
+            list_free(ls[s]);
+            plist_free(ps[s]);
+        }
+        free(ls);
+        free(ps);
+        list_free(l);
+        plist_free(p);
+    }
+    return sink == 42;
+}
@@ -1,16 +1,216 @@
 /* list_t.c */
 
 #include "list_t.h"
+#include "list_hash.h"
+#include <string.h>
+
+/* Element count index, used by both backends */
+
+/* Slot a pointer hashes to (Fibonacci hashing) */
+static size_t hash_slot(struct list_hash *h, void *x) {
+    return (size_t)(((uint64_t)(uintptr_t)x * 0x9e3779b97f4a7c15ULL) >> 32) & (h->cap - 1);
+}
+
+/* Slot holding x, or the empty slot where it would go */
+static size_t hash_find(struct list_hash *h, void *x) {
+    size_t i = hash_slot(h, x);
+    while (h->counts[i] != 0 && h->keys[i] != x) {
+        i = (i + 1) & (h->cap - 1);
+    }
+    return i;
+}
+
+/* Allocate cap empty slots */
+static void hash_alloc(struct list_hash *h, size_t cap) {
+    h->keys = (void **)malloc(cap * sizeof(void *));
+    h->counts = (size_t *)calloc(cap, sizeof(size_t));
+    if (h->keys == NULL || h->counts == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    h->cap = cap;
+    h->used = 0;
+}
+
+/* Create an empty index */
+struct list_hash *list_hash_new() {
+    struct list_hash *h = (struct list_hash *)malloc(sizeof(struct list_hash));
+    if (h == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    hash_alloc(h, 16);
+    return h;
+}
+
+/* Free an index */
+void list_hash_free(struct list_hash *h) {
+    if (h == NULL) {
+        return;
+    }
+    free(h->keys);
+    free(h->counts);
+    free(h);
+}
+
+/* Forget every element, keeping the table */
+void list_hash_clear(struct list_hash *h) {
+    memset(h->counts, 0, h->cap * sizeof(size_t));
+    h->used = 0;
+}
+
+/* Count one more x, doubling the table past 3/4 full */
+void list_hash_add(struct list_hash *h, void *x) {
+    size_t i = hash_find(h, x);
+
+    if (h->counts[i] == 0) {
+        if (4 * (h->used + 1) > 3 * h->cap) {
+            struct list_hash old = *h;
+            size_t j;
+            hash_alloc(h, 2 * old.cap);
+            for (j = 0; j < old.cap; j++) {
+                if (old.counts[j] != 0) {
+                    i = hash_find(h, old.keys[j]);
+                    h->keys[i] = old.keys[j];
+                    h->counts[i] = old.counts[j];
+                    h->used++;
+                }
+            }
+            free(old.keys);
+            free(old.counts);
+            i = hash_find(h, x);
+        }
+        h->keys[i] = x;
+        h->used++;
+    }
+    h->counts[i]++;
+}
+
+/* Count one less x; an emptied slot is refilled by shifting back later
+   entries of its probe run */
+void list_hash_sub(struct list_hash *h, void *x) {
+    size_t i = hash_find(h, x), j, home;
+
+    if (h->counts[i] == 0 || --h->counts[i] != 0) {
+        return;
+    }
+    h->used--;
+    for (j = (i + 1) & (h->cap - 1); h->counts[j] != 0; j = (j + 1) & (h->cap - 1)) {
+        home = hash_slot(h, h->keys[j]);
+
+        /* Move j into the hole unless its home lies cyclically in (i, j] */
+        if (((j - home) & (h->cap - 1)) >= ((j - i) & (h->cap - 1))) {
+            h->keys[i] = h->keys[j];
+            h->counts[i] = h->counts[j];
+            h->counts[j] = 0;
+            i = j;
+        }
+    }
+}
+
+/* Number of times x was counted */
+size_t list_hash_count(struct list_hash *h, void *x) {
+    return h->counts[hash_find(h, x)];
+}
+
+/* Linked backend; -DLIST_VEC selects list_vec.c instead */
+#ifndef LIST_VEC
+
+/* Chunks start small so short lists stay small, then double */
+#define CHUNK_MIN 8
+#define CHUNK_MAX 4096
+
+struct list_chunk {
+    struct list_chunk *next;
+    size_t used;            /* nodes handed out from the front */
+    size_t cap;
+    list_node nodes[];
+};
+
+/* Add an empty chunk of cap nodes as the list's newest */
+static struct list_chunk *chunk_new(list_t l, size_t cap) {
+    struct list_chunk *chunk = (struct list_chunk *)malloc(sizeof(struct list_chunk) + cap * sizeof(list_node));
+    if (chunk == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    chunk->next = l->chunks;
+    chunk->used = 0;
+    chunk->cap = cap;
+    l->chunks = chunk;
+    return chunk;
+}
+
+/* Take a node for x from the spare nodes or the newest chunk */
+static list_node *node_new(list_t l, void *x) {
+    list_node *node = l->spare;
+    struct list_chunk *chunk = l->chunks;
+
+    if (node != NULL) {
+        l->spare = node->next;
+    } else {
+        if (chunk == NULL || chunk->used == chunk->cap) {
+            chunk = chunk_new(l, chunk == NULL ? CHUNK_MIN
+                                 : chunk->cap < CHUNK_MAX ? 2 * chunk->cap : CHUNK_MAX);
+        }
+        node = &chunk->nodes[chunk->used++];
+    }
+    node->data = x;
+    node->next = NULL;
+    return node;
+}
+
+/* Give a node back to its list for reuse */
+static void node_free(list_t l, list_node *node) {
+    node->next = l->spare;
+    l->spare = node;
+}
+
+/* Free every chunk in a chain */
+static void chunks_free(struct list_chunk *chunk) {
+    struct list_chunk *next;
+    while (chunk != NULL) {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+/* Unlink and free the node after prev (the head if prev is NULL) */
+static void *node_unlink(list_t l, list_node *prev) {
+    list_node *node = prev ? prev->next : l->head;
+    void *result = node->data;
+
+    if (prev == NULL) {
+        l->head = node->next;
+    } else {
+        prev->next = node->next;
+    }
+    if (l->tail == node) {
+        l->tail = prev;
+    }
+    l->len--;
+    if (l->hash != NULL) {
+        list_hash_sub(l->hash, result);
+    }
+
+    node_free(l, node);
+    return result;
+}
 
 /* Create a new list */
 list_t list_new() {
-    list_t new_list = (list_t)malloc(2 * sizeof(void *));
+    list_t new_list = (list_t)malloc(sizeof(struct list_struct));
     if (new_list == NULL) {
         fprintf(stderr, "Memory allocation failed\n");
         exit(1);
     }
-    new_list[0] = NULL;  /* Data element (initially NULL) */
-    new_list[1] = NULL;  /* Next pointer (initially NULL - end of list) */
+    new_list->head = NULL;  /* First node (initially none) */
+    new_list->tail = NULL;  /* Last node, so append needs no walk */
+    new_list->len = 0;
+    new_list->chunks = NULL;  /* No nodes until the first append */
+    new_list->spare = NULL;
+    new_list->hash = NULL;    /* Not indexed unless asked */
     return new_list;
 }
 
@@ -19,313 +219,459 @@ void list_free(list_t l) {
     if (l == NULL) {
         return;
     }
-    
-    /* Free the rest of the list first */
-    if (l[1] != NULL) {
-        list_free((list_t)l[1]);
-    }
-    
-    /* Then free this node */
+
+    chunks_free(l->chunks);
+    list_hash_free(l->hash);
     free(l);
 }
 
 /* Print the list */
 void list_print(list_t l) {
     printf("[");
-    
-    list_t current = l;
+
+    list_node *current = l->head;
     int first = TRUE;
-    
-    while (current != NULL && current[0] != NULL) {
+
+    while (current != NULL) {
         if (!first) {
             printf(", ");
         }
-        printf("%lu", (uint64_t)current[0]);
+        printf("%lu", (uint64_t)current->data);
         first = FALSE;
-        current = (list_t)current[1];
+        current = current->next;
     }
-    
+
     printf("]\n");
 }
 
 /* Append an element to the list */
 void list_append(list_t l, void *x) {
-    /* Find the last node */
-    list_t current = l;
-    
-    /* Special case: empty list */
-    if (current[0] == NULL && current[1] == NULL) {
-        current[0] = x;
-        return;
+    list_node *new_node = node_new(l, x);
+
+    /* Link after the tail, or start the list */
+    if (l->tail == NULL) {
+        l->head = new_node;
+    } else {
+        l->tail->next = new_node;
     }
-    
-    /* Navigate to the last node */
-    while (current[1] != NULL) {
-        current = (list_t)current[1];
+    l->tail = new_node;
+    l->len++;
+    if (l->hash != NULL) {
+        list_hash_add(l->hash, x);
     }
-    
-    /* Create a new node and link it */
-    list_t new_node = list_new();
-    new_node[0] = x;
-    current[1] = new_node;
 }
 
 /* Extend the first list with the second list */
 void list_extend(list_t l1, list_t l2) {
-    list_t current_l2 = l2;
-    
-    /* Iterate through l2 and append each element to l1 */
-    while (current_l2 != NULL && current_l2[0] != NULL) {
-        list_append(l1, current_l2[0]);
-        current_l2 = (list_t)current_l2[1];
+    list_node *current_l2 = l2->head;
+    size_t n = l2->len;
+
+    /* Append each element of l2; counting keeps l1 == l2 finite */
+    while (n-- > 0) {
+        list_append(l1, current_l2->data);
+        current_l2 = current_l2->next;
     }
 }
 
 /* Insert an element at a specific index in the list */
 void list_insert(list_t l, size_t i, void *x) {
-    list_t current = l;
-    list_t prev = NULL;
-    size_t curr_index = 0;
-    
-    /* Special case: insert at beginning of empty list */
-    if (i == 0 && current[0] == NULL && current[1] == NULL) {
-        current[0] = x;
+    list_node *prev, *new_node;
+
+    /* At or beyond the end of the list, append */
+    if (i >= l->len) {
+        list_append(l, x);
         return;
     }
-    
-    /* Special case: insert at beginning of non-empty list */
+
+    /* At the beginning of the list */
+    new_node = node_new(l, x);
+    if (l->hash != NULL) {
+        list_hash_add(l->hash, x);
+    }
     if (i == 0) {
-        /* Create a new node with the same data as the head */
-        list_t new_node = list_new();
-        new_node[0] = current[0];
-        new_node[1] = current[1];
-        
-        /* Update the head node */
-        current[0] = x;
-        current[1] = new_node;
+        new_node->next = l->head;
+        l->head = new_node;
+        l->len++;
         return;
     }
-    
-    /* Navigate to the insertion point */
-    while (current != NULL && curr_index < i) {
-        prev = current;
-        current = (list_t)current[1];
-        curr_index++;
-        
-        /* If we've reached the end of the list */
-        if (current == NULL) {
-            break;
-        }
-    }
-    
-    /* If index is out of range (beyond end of list), append */
-    if (curr_index < i) {
-        list_t last = l;
-        while (last[1] != NULL) {
-            last = (list_t)last[1];
-        }
-        
-        list_t new_node = list_new();
-        new_node[0] = x;
-        last[1] = new_node;
-        return;
+
+    /* Navigate to the node before the insertion point */
+    prev = l->head;
+    while (--i > 0) {
+        prev = prev->next;
     }
-    
+
     /* Insert in the middle of the list */
-    list_t new_node = list_new();
-    new_node[0] = x;
-    new_node[1] = current;
-    prev[1] = new_node;
+    new_node->next = prev->next;
+    prev->next = new_node;
+    l->len++;
 }
 
 /* Remove the first occurrence of an element from the list */
 bool list_remove(list_t l, void *x) {
-    list_t current = l;
-    list_t prev = NULL;
-    
+    list_node *current = l->head;
+    list_node *prev = NULL;
+
+    /* Absent elements need no walk */
+    if (l->hash != NULL && list_hash_count(l->hash, x) == 0) {
+        return FALSE;
+    }
+
     /* Find the node with the value x */
-    while (current != NULL && current[0] != x) {
+    while (current != NULL && current->data != x) {
         prev = current;
-        current = (list_t)current[1];
+        current = current->next;
     }
-    
+
     /* If x was not found */
     if (current == NULL) {
         return FALSE;
     }
-    
-    /* If x is in the first node */
-    if (prev == NULL) {
-        /* Special case: only one element in the list */
-        if (current[1] == NULL) {
-            current[0] = NULL;  /* Empty the list */
-            return TRUE;
-        }
-        
-        /* Move the second element to the first position */
-        list_t next_node = (list_t)current[1];
-        current[0] = next_node[0];
-        current[1] = next_node[1];
-        
-        /* Free the second node */
-        next_node[0] = NULL;
-        next_node[1] = NULL;
-        free(next_node);
-    } else {
-        /* Remove the node from the middle or end of the list */
-        prev[1] = current[1];
-        free(current);
-    }
-    
+
+    node_unlink(l, prev);
     return TRUE;
 }
 
 /* Remove and return the element at a specific index */
 void *list_pop(list_t l, size_t i) {
-    list_t current = l;
-    list_t prev = NULL;
-    size_t curr_index = 0;
-    void *result;
-    
-    /* Navigate to the node at index i */
-    while (current != NULL && curr_index < i) {
-        prev = current;
-        current = (list_t)current[1];
-        curr_index++;
-    }
-    
+    list_node *prev = NULL;
+
     /* If index is out of range */
-    if (current == NULL) {
+    if (i >= l->len) {
         fprintf(stderr, "Index out of range\n");
         exit(1);
     }
-    
-    /* Get the value to return */
-    result = current[0];
-    
-    /* If popping the first element */
-    if (prev == NULL) {
-        /* Special case: only one element in the list */
-        if (current[1] == NULL) {
-            current[0] = NULL;  /* Empty the list */
-            return result;
+
+    /* Navigate to the node before index i */
+    if (i > 0) {
+        prev = l->head;
+        while (--i > 0) {
+            prev = prev->next;
         }
-        
-        /* Move the second element to the first position */
-        list_t next_node = (list_t)current[1];
-        current[0] = next_node[0];
-        current[1] = next_node[1];
-        
-        /* Free the second node */
-        next_node[0] = NULL;
-        next_node[1] = NULL;
-        free(next_node);
-    } else {
-        /* Remove the node from the middle or end of the list */
-        prev[1] = current[1];
-        free(current);
     }
-    
-    return result;
+
+    return node_unlink(l, prev);
 }
 
-/* Clear the list */
+/* Clear the list, keeping only the newest (largest) chunk for reuse */
 void list_clear(list_t l) {
-    /* Free all nodes except the head */
-    if (l[1] != NULL) {
-        list_free((list_t)l[1]);
-        l[1] = NULL;
+    if (l->chunks != NULL) {
+        chunks_free(l->chunks->next);
+        l->chunks->next = NULL;
+        l->chunks->used = 0;
+    }
+    l->spare = NULL;
+    l->head = NULL;
+    l->tail = NULL;
+    l->len = 0;
+    if (l->hash != NULL) {
+        list_hash_clear(l->hash);
     }
-    
-    /* Clear the head node */
-    l[0] = NULL;
 }
 
 /* Get the index of the first occurrence of an element */
 size_t list_index(list_t l, void *x) {
-    list_t current = l;
+    list_node *current = l->head;
     size_t index = 0;
-    
+
+    /* Absent elements need no walk */
+    if (l->hash != NULL && list_hash_count(l->hash, x) == 0) {
+        current = NULL;
+    }
+
     /* Find the first occurrence of x */
-    while (current != NULL && current[0] != x) {
-        current = (list_t)current[1];
+    while (current != NULL && current->data != x) {
+        current = current->next;
         index++;
-        
-        /* If we've reached the end of the list */
-        if (current == NULL) {
-            fprintf(stderr, "Value not found in list\n");
-            exit(1);
-        }
     }
-    
+
+    /* If we've reached the end of the list */
+    if (current == NULL) {
+        fprintf(stderr, "Value not found in list\n");
+        exit(1);
+    }
+
     return index;
 }
 
 /* Count the occurrences of an element in the list */
 uint64_t list_count(list_t l, void *x) {
-    list_t current = l;
+    list_node *current = l->head;
     uint64_t count = 0;
-    
+
+    if (l->hash != NULL) {
+        return list_hash_count(l->hash, x);
+    }
+
     /* Count occurrences of x */
     while (current != NULL) {
-        if (current[0] == x) {
+        if (current->data == x) {
             count++;
         }
-        current = (list_t)current[1];
+        current = current->next;
     }
-    
+
     return count;
 }
 
-/* Reverse the list */
+/* Reverse the list by relinking its nodes in place */
 void list_reverse(list_t l) {
-    /* Empty or single-element list */
-    if (l == NULL || l[0] == NULL || l[1] == NULL) {
+    list_node *prev = NULL, *current = l->head, *next;
+
+    /* Turn each next pointer around */
+    while (current != NULL) {
+        next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+
+    /* The old head is the new tail */
+    l->tail = l->head;
+    l->head = prev;
+}
+
+/* Create a copy of the list in one exactly sized chunk, in one pass */
+list_t list_copy(list_t l) {
+    list_t new_list = list_new();
+    list_node *current = l->head, *nodes;
+    size_t i;
+
+    if (l->len == 0) {
+        return new_list;
+    }
+    nodes = chunk_new(new_list, l->len)->nodes;
+    new_list->chunks->used = l->len;
+
+    /* Copy each element, linking each node to the one after it */
+    for (i = 0; i < l->len; i++) {
+        nodes[i].data = current->data;
+        nodes[i].next = &nodes[i + 1];
+        current = current->next;
+    }
+    nodes[l->len - 1].next = NULL;
+
+    new_list->head = &nodes[0];
+    new_list->tail = &nodes[l->len - 1];
+    new_list->len = l->len;
+    return new_list;
+}
+
+/* Get the number of elements in the list */
+size_t list_len(list_t l) {
+    return l->len;
+}
+
+/* Move all nodes of the second list onto the end of the first */
+void list_splice(list_t l1, list_t l2) {
+    if (l1 == l2 || l2->head == NULL) {
         return;
     }
-    
-    /* Copy all elements to an array */
-    size_t length = 0;
-    list_t current = l;
-    while (current != NULL && current[0] != NULL) {
-        length++;
-        current = (list_t)current[1];
-    }
-    
-    void **elements = (void **)malloc(length * sizeof(void *));
-    if (elements == NULL) {
-        fprintf(stderr, "Memory allocation failed\n");
-        exit(1);
+
+    /* Link l2's chain after l1's tail */
+    if (l1->tail == NULL) {
+        l1->head = l2->head;
+    } else {
+        l1->tail->next = l2->head;
+    }
+    l1->tail = l2->tail;
+    l1->len += l2->len;
+
+    /* Indexes follow the elements */
+    if (l1->hash != NULL) {
+        list_node *current;
+        for (current = l2->head; current != NULL; current = current->next) {
+            list_hash_add(l1->hash, current->data);
+        }
     }
-    
-    current = l;
-    for (size_t i = 0; i < length; i++) {
-        elements[i] = current[0];
-        current = (list_t)current[1];
+    if (l2->hash != NULL) {
+        list_hash_clear(l2->hash);
     }
-    
-    /* Clear the list */
-    list_clear(l);
-    
-    /* Rebuild the list in reverse order */
-    for (size_t i = 0; i < length; i++) {
-        list_append(l, elements[length - 1 - i]);
+
+    /* l1 adopts l2's chunks behind its own newest one, so it keeps
+       carving from that; l2's spare nodes are left unused in them */
+    if (l1->chunks == NULL) {
+        l1->chunks = l2->chunks;
+    } else {
+        struct list_chunk *last = l2->chunks;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        last->next = l1->chunks->next;
+        l1->chunks->next = l2->chunks;
     }
-    
-    /* Free the temporary array */
-    free(elements);
+
+    /* l2 no longer owns any nodes */
+    l2->chunks = NULL;
+    l2->spare = NULL;
+    l2->head = NULL;
+    l2->tail = NULL;
+    l2->len = 0;
 }
 
-/* Create a copy of the list */
-list_t list_copy(list_t l) {
-    list_t new_list = list_new();
-    list_t current = l;
-    
-    /* Copy each element */
-    while (current != NULL && current[0] != NULL) {
-        list_append(new_list, current[0]);
-        current = (list_t)current[1];
-    }
-    
-    return new_list;
-}
\ No newline at end of file
+/* Merge two sorted chains, a's elements first among equals */
+static list_node *merge(list_node *a, list_node *b, bool (greater_than)(void *, void *)) {
+    list_node head, *tail = &head;
+
+    while (a != NULL && b != NULL) {
+        if (greater_than(a->data, b->data)) {
+            tail->next = b;
+            b = b->next;
+        } else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a != NULL ? a : b;
+    return head.next;
+}
+
+/* Sort the list with a stable bottom-up merge sort. bins[i] holds a
+   sorted run of 2^i nodes taken before any run in a lower bin, so each
+   node is merged into runs like a binary counter and nothing is
+   allocated. */
+void list_sort(list_t l, bool (greater_than)(void *, void *)) {
+    list_node *bins[64] = {NULL}, *run, *next;
+    size_t i, fill = 0;
+
+    if (l->len < 2) {
+        return;
+    }
+    for (run = l->head; run != NULL; run = next) {
+        next = run->next;
+        run->next = NULL;
+        for (i = 0; bins[i] != NULL; i++) {
+            run = merge(bins[i], run, greater_than);
+            bins[i] = NULL;
+        }
+        bins[i] = run;
+        if (i == fill) {
+            fill++;
+        }
+    }
+
+    /* Fold the bins together, older (higher) runs first */
+    run = NULL;
+    for (i = 0; i < fill; i++) {
+        if (bins[i] != NULL) {
+            run = run == NULL ? bins[i] : merge(bins[i], run, greater_than);
+        }
+    }
+
+    l->head = run;
+    while (run->next != NULL) {
+        run = run->next;
+    }
+    l->tail = run;
+}
+
+/* Start keeping an element count index, built from the current contents */
+void list_hash_on(list_t l) {
+    list_node *current;
+
+    if (l->hash != NULL) {
+        return;
+    }
+    l->hash = list_hash_new();
+    for (current = l->head; current != NULL; current = current->next) {
+        list_hash_add(l->hash, current->data);
+    }
+}
+
+/* Drop the element count index */
+void list_hash_off(list_t l) {
+    list_hash_free(l->hash);
+    l->hash = NULL;
+}
+
+/* Check whether an element is in the list */
+bool list_contains(list_t l, void *x) {
+    list_node *current;
+
+    if (l->hash != NULL) {
+        return list_hash_count(l->hash, x) != 0;
+    }
+    for (current = l->head; current != NULL; current = current->next) {
+        if (current->data == x) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* A cursor on the first element */
+list_cursor list_begin(list_t l) {
+    list_cursor c;
+    c.l = l;
+    c.prev = NULL;
+    c.node = l->head;
+    return c;
+}
+
+/* Check whether the cursor is past the last element */
+bool list_done(list_cursor *c) {
+    return c->node == NULL;
+}
+
+/* Move the cursor to the following element */
+bool list_next(list_cursor *c) {
+    if (c->node != NULL) {
+        c->prev = c->node;
+        c->node = c->node->next;
+    }
+    return c->node != NULL;
+}
+
+/* Element at the cursor */
+void *list_get(list_cursor *c) {
+    return c->node->data;
+}
+
+/* Replace the element at the cursor */
+void list_set(list_cursor *c, void *x) {
+    if (c->l->hash != NULL) {
+        list_hash_sub(c->l->hash, c->node->data);
+        list_hash_add(c->l->hash, x);
+    }
+    c->node->data = x;
+}
+
+/* Insert after the cursor, or append if it is at the end */
+void list_insert_after(list_cursor *c, void *x) {
+    list_t l = c->l;
+    list_node *new_node;
+
+    if (c->node == NULL) {
+        list_append(l, x);
+        c->node = l->tail;
+        return;
+    }
+    new_node = node_new(l, x);
+    new_node->next = c->node->next;
+    c->node->next = new_node;
+    if (l->tail == c->node) {
+        l->tail = new_node;
+    }
+    l->len++;
+    if (l->hash != NULL) {
+        list_hash_add(l->hash, x);
+    }
+}
+
+/* Remove the element at the cursor, moving on to the following one */
+void *list_erase(list_cursor *c) {
+    void *result = node_unlink(c->l, c->prev);
+    c->node = c->prev != NULL ? c->prev->next : c->l->head;
+    return result;
+}
+
+/* Call f on every element in order */
+void list_foreach(list_t l, void (*f)(void *x, void *arg), void *arg) {
+    list_node *current;
+    for (current = l->head; current != NULL; current = current->next) {
+        f(current->data, arg);
+    }
+}
+
+#endif /* LIST_VEC */
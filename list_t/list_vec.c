@@ -0,0 +1,473 @@
+/* list_vec.c */
+
+/*
+ Array backend for list_t, built with -DLIST_VEC:
+   gcc -DLIST_VEC tester.c list_t.c list_vec.c
+ Elements live in one void * array with a gap at the last edit point.
+ Moving the gap costs the distance moved, so appends, runs of inserts or
+ pops at one place, and front-to-back edits are all cheap.
+ */
+
+#include "list_t.h"
+#include "list_hash.h"
+
+#ifdef LIST_VEC
+
+#include <string.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* Number of elements */
+#define LEN(l) ((l)->cap - ((l)->gap_end - (l)->gap))
+
+/* Address of element i */
+#define AT(l, i) (&(l)->eles[(i) < (l)->gap ? (i) : (i) + ((l)->gap_end - (l)->gap)])
+
+/* Move the gap so it starts at logical index i */
+static void gap_move(list_t l, size_t i) {
+    if (i < l->gap) {
+        memmove(&l->eles[l->gap_end - (l->gap - i)], &l->eles[i], (l->gap - i) * sizeof(void *));
+        l->gap_end -= l->gap - i;
+        l->gap = i;
+    } else if (i > l->gap) {
+        memmove(&l->eles[l->gap], &l->eles[l->gap_end], (i - l->gap) * sizeof(void *));
+        l->gap_end += i - l->gap;
+        l->gap = i;
+    }
+}
+
+/* Make room for n more elements in the gap */
+static void gap_reserve(list_t l, size_t n) {
+    size_t tail = l->cap - l->gap_end, cap = l->cap ? l->cap : 8;
+    void **eles;
+
+    if (l->gap_end - l->gap >= n) {
+        return;
+    }
+    while (cap - (l->gap + tail) < n) {
+        cap *= 2;
+    }
+    eles = (void **)realloc(l->eles, cap * sizeof(void *));
+    if (eles == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+
+    /* The part after the gap moves to the new end */
+    memmove(&eles[cap - tail], &eles[l->gap_end], tail * sizeof(void *));
+    l->eles = eles;
+    l->gap_end = cap - tail;
+    l->cap = cap;
+}
+
+/* Index of the first x in eles[0, n), n if none */
+static size_t scan(void **eles, size_t n, void *x) {
+    size_t i = 0;
+#ifdef __AVX2__
+    __m256i key = _mm256_set1_epi64x((long long)(uintptr_t)x);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&eles[i]);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, key)));
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (eles[i] == x) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/* Number of x in eles[0, n) */
+static uint64_t tally(void **eles, size_t n, void *x) {
+    uint64_t count = 0;
+    size_t i = 0;
+#ifdef __AVX2__
+    __m256i key = _mm256_set1_epi64x((long long)(uintptr_t)x);
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&eles[i]);
+        acc = _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(v, key));  /* -1 per match */
+    }
+    count = (uint64_t)_mm256_extract_epi64(acc, 0) + (uint64_t)_mm256_extract_epi64(acc, 1)
+          + (uint64_t)_mm256_extract_epi64(acc, 2) + (uint64_t)_mm256_extract_epi64(acc, 3);
+#endif
+    for (; i < n; i++) {
+        count += eles[i] == x;
+    }
+    return count;
+}
+
+/* Create a new list */
+list_t list_new() {
+    list_t new_list = (list_t)malloc(sizeof(struct list_struct));
+    if (new_list == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    new_list->eles = NULL;  /* No storage until the first element */
+    new_list->gap = 0;
+    new_list->gap_end = 0;
+    new_list->cap = 0;
+    new_list->hash = NULL;  /* Not indexed unless asked */
+    return new_list;
+}
+
+/* Free the memory used by the list */
+void list_free(list_t l) {
+    if (l == NULL) {
+        return;
+    }
+    free(l->eles);
+    list_hash_free(l->hash);
+    free(l);
+}
+
+/* Print the list */
+void list_print(list_t l) {
+    size_t i, n = LEN(l);
+
+    printf("[");
+    for (i = 0; i < n; i++) {
+        if (i > 0) {
+            printf(", ");
+        }
+        printf("%lu", (uint64_t)*AT(l, i));
+    }
+    printf("]\n");
+}
+
+/* Append an element to the list */
+void list_append(list_t l, void *x) {
+    gap_move(l, LEN(l));
+    gap_reserve(l, 1);
+    l->eles[l->gap++] = x;
+    if (l->hash != NULL) {
+        list_hash_add(l->hash, x);
+    }
+}
+
+/* Extend the first list with the second list */
+void list_extend(list_t l1, list_t l2) {
+    size_t n = LEN(l2), head;
+
+    if (n == 0) {
+        return;
+    }
+    gap_move(l1, LEN(l1));
+    gap_reserve(l1, n);
+
+    /* With l1 == l2 the elements are now exactly [0, gap) */
+    head = l2->gap < n ? l2->gap : n;
+    memcpy(&l1->eles[l1->gap], l2->eles, head * sizeof(void *));
+    memcpy(&l1->eles[l1->gap + head], &l2->eles[l2->gap_end], (n - head) * sizeof(void *));
+    if (l1->hash != NULL) {
+        for (head = 0; head < n; head++) {
+            list_hash_add(l1->hash, l1->eles[l1->gap + head]);
+        }
+    }
+    l1->gap += n;
+}
+
+/* Insert an element at a specific index in the list */
+void list_insert(list_t l, size_t i, void *x) {
+    size_t n = LEN(l);
+
+    /* At or beyond the end of the list, append */
+    gap_move(l, i < n ? i : n);
+    gap_reserve(l, 1);
+    l->eles[l->gap++] = x;
+    if (l->hash != NULL) {
+        list_hash_add(l->hash, x);
+    }
+}
+
+/* Remove and return the element at a specific index */
+void *list_pop(list_t l, size_t i) {
+    /* If index is out of range */
+    if (i >= LEN(l)) {
+        fprintf(stderr, "Index out of range\n");
+        exit(1);
+    }
+
+    /* The element just after the gap joins it */
+    gap_move(l, i);
+    if (l->hash != NULL) {
+        list_hash_sub(l->hash, l->eles[l->gap_end]);
+    }
+    return l->eles[l->gap_end++];
+}
+
+/* Remove the first occurrence of an element from the list */
+bool list_remove(list_t l, void *x) {
+    size_t i;
+
+    /* Absent elements need no scan */
+    if (l->hash != NULL && list_hash_count(l->hash, x) == 0) {
+        return FALSE;
+    }
+    i = scan(l->eles, l->gap, x);
+
+    if (i == l->gap) {
+        i = l->gap + scan(&l->eles[l->gap_end], l->cap - l->gap_end, x);
+        if (i == LEN(l)) {
+            return FALSE;
+        }
+    }
+    list_pop(l, i);
+    return TRUE;
+}
+
+/* Clear the list, keeping its storage */
+void list_clear(list_t l) {
+    l->gap = 0;
+    l->gap_end = l->cap;
+    if (l->hash != NULL) {
+        list_hash_clear(l->hash);
+    }
+}
+
+/* Get the index of the first occurrence of an element */
+size_t list_index(list_t l, void *x) {
+    size_t i = LEN(l);
+
+    /* Absent elements need no scan */
+    if (l->hash == NULL || list_hash_count(l->hash, x) != 0) {
+        i = scan(l->eles, l->gap, x);
+        if (i == l->gap) {
+            i = l->gap + scan(&l->eles[l->gap_end], l->cap - l->gap_end, x);
+        }
+    }
+
+    /* If we've reached the end of the list */
+    if (i == LEN(l)) {
+        fprintf(stderr, "Value not found in list\n");
+        exit(1);
+    }
+    return i;
+}
+
+/* Count the occurrences of an element in the list */
+uint64_t list_count(list_t l, void *x) {
+    if (l->hash != NULL) {
+        return list_hash_count(l->hash, x);
+    }
+    return tally(l->eles, l->gap, x) + tally(&l->eles[l->gap_end], l->cap - l->gap_end, x);
+}
+
+/* Reverse the list in place */
+void list_reverse(list_t l) {
+    size_t i, n = LEN(l);
+    void *t;
+
+    gap_move(l, n);
+    for (i = 0; i < n / 2; i++) {
+        t = l->eles[i];
+        l->eles[i] = l->eles[n - 1 - i];
+        l->eles[n - 1 - i] = t;
+    }
+}
+
+/* Create a copy of the list, sized exactly */
+list_t list_copy(list_t l) {
+    list_t new_list = list_new();
+    size_t n = LEN(l);
+
+    if (n == 0) {
+        return new_list;
+    }
+    new_list->eles = (void **)malloc(n * sizeof(void *));
+    if (new_list->eles == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    memcpy(new_list->eles, l->eles, l->gap * sizeof(void *));
+    memcpy(&new_list->eles[l->gap], &l->eles[l->gap_end], (n - l->gap) * sizeof(void *));
+    new_list->gap = new_list->gap_end = new_list->cap = n;
+    return new_list;
+}
+
+/* Get the number of elements in the list */
+size_t list_len(list_t l) {
+    return LEN(l);
+}
+
+/* Move all elements of the second list onto the end of the first; an
+   empty unindexed l1 just takes l2's storage */
+void list_splice(list_t l1, list_t l2) {
+    struct list_struct t;
+
+    if (l1 == l2) {
+        return;
+    }
+    if (LEN(l1) == 0 && l1->hash == NULL) {
+        t = *l1;
+        l1->eles = l2->eles;
+        l1->gap = l2->gap;
+        l1->gap_end = l2->gap_end;
+        l1->cap = l2->cap;
+        l2->eles = t.eles;
+        l2->gap = t.gap;
+        l2->gap_end = t.gap_end;
+        l2->cap = t.cap;
+    } else {
+        list_extend(l1, l2);
+    }
+    list_clear(l2);
+}
+
+/* Sort the list with a stable bottom-up merge sort through one n slot
+   buffer; runs of 16 are insertion sorted first */
+void list_sort(list_t l, bool (greater_than)(void *, void *)) {
+    size_t n = LEN(l), width, lo, mid, hi, i, j, k;
+    void **src, **dst, **t, *x;
+
+    if (n < 2) {
+        return;
+    }
+    gap_move(l, n);
+    src = l->eles;
+    for (lo = 0; lo < n; lo += 16) {
+        hi = lo + 16 < n ? lo + 16 : n;
+        for (i = lo + 1; i < hi; i++) {
+            x = src[i];
+            for (j = i; j > lo && greater_than(src[j - 1], x); j--) {
+                src[j] = src[j - 1];
+            }
+            src[j] = x;
+        }
+    }
+    if (n <= 16) {
+        return;
+    }
+
+    dst = (void **)malloc(n * sizeof(void *));
+    if (dst == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    for (width = 16; width < n; width *= 2) {
+        for (lo = 0; lo < n; lo += 2 * width) {
+            mid = lo + width < n ? lo + width : n;
+            hi = lo + 2 * width < n ? lo + 2 * width : n;
+            for (i = lo, j = mid, k = lo; k < hi; k++) {
+                if (i < mid && (j == hi || !greater_than(src[i], src[j]))) {
+                    dst[k] = src[i++];
+                } else {
+                    dst[k] = src[j++];
+                }
+            }
+        }
+        t = src;
+        src = dst;
+        dst = t;
+    }
+
+    /* src holds the result; keep whichever array that is */
+    if (src != l->eles) {
+        free(l->eles);
+        l->eles = src;
+        l->gap = n;
+        l->gap_end = n;
+        l->cap = n;
+    } else {
+        free(dst);
+    }
+}
+
+/* A cursor on the first element */
+list_cursor list_begin(list_t l) {
+    list_cursor c;
+    c.l = l;
+    c.index = 0;
+    return c;
+}
+
+/* Check whether the cursor is past the last element */
+bool list_done(list_cursor *c) {
+    return c->index >= LEN(c->l);
+}
+
+/* Move the cursor to the following element */
+bool list_next(list_cursor *c) {
+    if (c->index < LEN(c->l)) {
+        c->index++;
+    }
+    return c->index < LEN(c->l);
+}
+
+/* Element at the cursor */
+void *list_get(list_cursor *c) {
+    return *AT(c->l, c->index);
+}
+
+/* Replace the element at the cursor */
+void list_set(list_cursor *c, void *x) {
+    void **slot = AT(c->l, c->index);
+    if (c->l->hash != NULL) {
+        list_hash_sub(c->l->hash, *slot);
+        list_hash_add(c->l->hash, x);
+    }
+    *slot = x;
+}
+
+/* Insert after the cursor, or append if it is at the end; the gap
+   follows the cursor, so a pass of inserts is linear */
+void list_insert_after(list_cursor *c, void *x) {
+    if (c->index >= LEN(c->l)) {
+        list_append(c->l, x);
+        c->index = LEN(c->l) - 1;
+        return;
+    }
+    list_insert(c->l, c->index + 1, x);
+}
+
+/* Remove the element at the cursor, moving on to the following one */
+void *list_erase(list_cursor *c) {
+    return list_pop(c->l, c->index);
+}
+
+/* Call f on every element in order, a segment at a time */
+void list_foreach(list_t l, void (*f)(void *x, void *arg), void *arg) {
+    size_t i;
+    for (i = 0; i < l->gap; i++) {
+        f(l->eles[i], arg);
+    }
+    for (i = l->gap_end; i < l->cap; i++) {
+        f(l->eles[i], arg);
+    }
+}
+
+/* Start keeping an element count index, built from the current contents */
+void list_hash_on(list_t l) {
+    size_t i, n = LEN(l);
+
+    if (l->hash != NULL) {
+        return;
+    }
+    l->hash = list_hash_new();
+    for (i = 0; i < n; i++) {
+        list_hash_add(l->hash, *AT(l, i));
+    }
+}
+
+/* Drop the element count index */
+void list_hash_off(list_t l) {
+    list_hash_free(l->hash);
+    l->hash = NULL;
+}
+
+/* Check whether an element is in the list */
+bool list_contains(list_t l, void *x) {
+    if (l->hash != NULL) {
+        return list_hash_count(l->hash, x) != 0;
+    }
+    return scan(l->eles, l->gap, x) < l->gap
+        || scan(&l->eles[l->gap_end], l->cap - l->gap_end, x) < l->cap - l->gap_end;
+}
+
+#endif /* LIST_VEC */
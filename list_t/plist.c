@@ -0,0 +1,211 @@
+/* plist.c */
+
+#include "plist.h"
+
+/* Make a node holding one reference to next */
+static plist_node *node_new(void *x, plist_node *next) {
+    plist_node *node = (plist_node *)malloc(sizeof(plist_node));
+    if (node == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    node->data = x;
+    node->next = next;
+    node->refs = 1;
+    if (next != NULL) {
+        next->refs++;
+    }
+    return node;
+}
+
+/* Drop one reference to node, freeing the run of nodes left unreferenced */
+static void node_release(plist_node *node) {
+    plist_node *next;
+
+    while (node != NULL && --node->refs == 0) {
+        next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+/*
+ The link (l->head or some next) that points at node i, after making
+ every node before i private to l. Walking from the head, a node with
+ other references is replaced in l by a copy; the copy takes a new
+ reference to the rest of the chain, so from there on every node is
+ shared and copied until i.
+ */
+static plist_node **own(plist_t l, size_t i) {
+    plist_node **link = &l->head;
+    plist_node *node;
+
+    while (i-- > 0) {
+        node = *link;
+        if (node->refs > 1) {
+            *link = node_new(node->data, node->next);
+            node->refs--;
+        }
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/* Create a new list */
+plist_t plist_new() {
+    plist_t l = (plist_t)malloc(sizeof(struct plist_struct));
+    if (l == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    l->head = NULL;
+    l->len = 0;
+    return l;
+}
+
+/* Free the list and the nodes only it used */
+void plist_free(plist_t l) {
+    node_release(l->head);
+    free(l);
+}
+
+/* Print the list */
+void plist_print(plist_t l) {
+    plist_node *current;
+
+    printf("[");
+    for (current = l->head; current != NULL; current = current->next) {
+        printf(current == l->head ? "%lu" : ", %lu", (uint64_t)current->data);
+    }
+    printf("]\n");
+}
+
+/* Share every node with a new list */
+plist_t plist_copy(plist_t l) {
+    plist_t r = plist_new();
+
+    r->head = l->head;
+    r->len = l->len;
+    if (r->head != NULL) {
+        r->head->refs++;
+    }
+    return r;
+}
+
+/* Add an element to the front, sharing nothing new */
+void plist_push(plist_t l, void *x) {
+    plist_node *node = node_new(x, l->head);
+
+    /* node took its own reference to the old head, drop the list's */
+    node_release(l->head);
+    l->head = node;
+    l->len++;
+}
+
+/* Insert an element at an index */
+void plist_insert(plist_t l, size_t i, void *x) {
+    plist_node **link;
+
+    if (i > l->len) {
+        fprintf(stderr, "Index out of range\n");
+        exit(1);
+    }
+    link = own(l, i);
+
+    /* The new node takes over the link's reference to node i */
+    *link = node_new(x, *link);
+    if ((*link)->next != NULL) {
+        (*link)->next->refs--;
+    }
+    l->len++;
+}
+
+/* Append an element */
+void plist_append(plist_t l, void *x) {
+    plist_insert(l, l->len, x);
+}
+
+/* Remove and return the element at an index */
+void *plist_pop(plist_t l, size_t i) {
+    plist_node **link, *node;
+    void *x;
+
+    if (i >= l->len) {
+        fprintf(stderr, "Index out of range\n");
+        exit(1);
+    }
+    link = own(l, i);
+    node = *link;
+    x = node->data;
+
+    /* Point past node with a reference of our own, then drop node's */
+    *link = node->next;
+    if (node->next != NULL) {
+        node->next->refs++;
+    }
+    node_release(node);
+    l->len--;
+    return x;
+}
+
+/* Get the element at an index */
+void *plist_get(plist_t l, size_t i) {
+    plist_node *current = l->head;
+
+    if (i >= l->len) {
+        fprintf(stderr, "Index out of range\n");
+        exit(1);
+    }
+    while (i-- > 0) {
+        current = current->next;
+    }
+    return current->data;
+}
+
+/* Replace the element at an index in this list only */
+void plist_set(plist_t l, size_t i, void *x) {
+    plist_node **link, *node;
+
+    if (i >= l->len) {
+        fprintf(stderr, "Index out of range\n");
+        exit(1);
+    }
+    link = own(l, i);
+    node = *link;
+    if (node->refs > 1) {
+        *link = node_new(x, node->next);
+        node->refs--;
+    } else {
+        node->data = x;
+    }
+}
+
+/* Get the number of elements in the list */
+size_t plist_len(plist_t l) {
+    return l->len;
+}
+
+/* Build a plist from a list_t, linking each new node after the last */
+plist_t plist_from_list(list_t l) {
+    plist_t r = plist_new();
+    plist_node **link = &r->head;
+    list_cursor c;
+
+    for (c = list_begin(l); !list_done(&c); list_next(&c)) {
+        *link = node_new(list_get(&c), NULL);
+        link = &(*link)->next;
+        r->len++;
+    }
+    return r;
+}
+
+/* Build a list_t from a plist */
+list_t plist_to_list(plist_t l) {
+    list_t r = list_new();
+    plist_node *current;
+
+    for (current = l->head; current != NULL; current = current->next) {
+        list_append(r, current->data);
+    }
+    return r;
+}
@@ -0,0 +1,144 @@
+/* plist.h */
+
+/* declares functions in plist.c */
+
+#ifndef PLIST_T
+#define PLIST_T
+
+#include "list_t.h"
+
+/* Notes:
+
+ A plist_t is a persistent list: a handle on a chain of reference
+ counted nodes that any number of plist_ts may share
+ plist_copy is O(1), the copy shares every node with the original
+ A change at index i copies only the shared nodes in [0, i] (and
+ nothing if l already owns them), the tail after i stays shared, so
+ many snapshots that differ a little cost little more than one list
+ Nodes are owned only from the front: appending to or editing near the
+ end of a shared list copies almost all of it, so push at the front
+ Reference counts are not atomic; plist_ts sharing nodes must stay on
+ one thread
+ Same element and index conventions as list_t
+ */
+
+typedef struct plist_node {
+    void *data;
+    struct plist_node *next;
+    size_t refs;    /* plist_ts and nodes pointing here */
+} plist_node;
+
+typedef struct plist_struct {
+    plist_node *head;
+    size_t len;
+} *plist_t;
+
+/*
+ _: New
+ inputs: none
+ outputs: a new plist_t containing no values
+ side effects: none
+ */
+plist_t plist_new();
+
+/*
+ _: Free
+ inputs: a plist_t l
+ outputs: nothing
+ side effects: frees l and every node no other plist_t shares
+ */
+void plist_free(plist_t l);
+
+/*
+ _: Print
+ inputs: a plist_t l
+ outputs: nothing
+ side effects: the elements of l are printed as in list_print
+ */
+void plist_print(plist_t l);
+
+/*
+ 0: Copy
+ inputs: a plist_t l
+ outputs: a plist_t r with the elements of l, sharing all its nodes, in O(1)
+ side effects: none
+ example:
+ plist_t l = plist_new();
+ plist_push(l, (void *)1);
+ plist_t r = plist_copy(l);
+ plist_push(l, (void *)2);
+ plist_print(l);
+ plist_print(r);
+ - should print "[2, 1]" then "[1]"
+ */
+plist_t plist_copy(plist_t l);
+
+/*
+ 1: Push
+ inputs: a plist_t l, and a pointer to an memory object of any type x
+ outputs: nothing
+ side effects: x is added to the front of l, in O(1)
+ */
+void plist_push(plist_t l, void *x);
+
+/*
+ 2: Insert
+ inputs: a plist_t l, size_t list index i (at most the length), and a
+ pointer to an memory object of any type x
+ outputs: nothing
+ side effects: x is added to l with index i, copying the shared nodes
+ before i; exit(1) if i is out of range
+ */
+void plist_insert(plist_t l, size_t i, void *x);
+
+/*
+ 3: Append
+ inputs: a plist_t l, and a pointer to an memory object of any type x
+ outputs: nothing
+ side effects: x is added to the end of l, O(n) (plist_insert at the length)
+ */
+void plist_append(plist_t l, void *x);
+
+/*
+ 4: Pop
+ inputs: a plist_t l, and a size_t list index i
+ outputs: The element at index i, or exit(1) if i is out of range
+ side effects: remove the element at index i, copying the shared nodes
+ before i
+ */
+void *plist_pop(plist_t l, size_t i);
+
+/*
+ 5: Get / Set
+ inputs: a plist_t l, a size_t list index i, and for set a pointer x
+ outputs: the element at index i (get), or exit(1) if i is out of range
+ side effects: set replaces the element at index i with x, copying the
+ shared nodes in [0, i]; other plist_ts keep the old element
+ example:
+ plist_t l = plist_new();
+ plist_push(l, (void *)1);
+ plist_t r = plist_copy(l);
+ plist_set(r, 0, (void *)2);
+ printf("%lu %lu\n", (uint64_t)plist_get(l, 0), (uint64_t)plist_get(r, 0));
+ - should print "1 2"
+ */
+void *plist_get(plist_t l, size_t i);
+void plist_set(plist_t l, size_t i, void *x);
+
+/*
+ 6: Length
+ inputs: a plist_t l
+ outputs: the number of elements in l, in O(1)
+ side effects: none
+ */
+size_t plist_len(plist_t l);
+
+/*
+ 7: Conversion
+ plist_from_list: a new plist_t with the elements of the list_t l, O(n)
+ plist_to_list: a new list_t with the elements of the plist_t l, O(n)
+ */
+plist_t plist_from_list(list_t l);
+list_t plist_to_list(plist_t l);
+
+#endif
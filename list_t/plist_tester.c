@@ -0,0 +1,78 @@
+/* plist_tester.c */
+
+/* tests plist.c functionality */
+
+/*
+ * gcc plist_tester.c plist.c list_t.c list_vec.c -o plist_tester
+ */
+
+#include "plist.h"
+
+int main()
+{
+    plist_t l = plist_new(), r, s;
+    list_t m;
+    uint64_t i;
+
+    printf("\nInitial Test\n");
+    printf("Make new and print plist_t should print:\n");
+    printf("[]\n");
+    printf("Does print:\n");
+    plist_print(l);
+
+    /* Build [1, 2, 3, 4] */
+
+    for (i = 4; i > 0; i--) {
+        plist_push(l, (void *)i);
+    }
+
+    printf("\n0. Copy\n");
+    printf("Copy [1, 2, 3, 4], push 0 onto the copy, should print:\n");
+    printf("[1, 2, 3, 4]\n");
+    printf("[0, 1, 2, 3, 4]\n");
+    printf("Does print:\n");
+    r = plist_copy(l);
+    plist_push(r, (void *)0);
+    plist_print(l);
+    plist_print(r);
+
+    printf("\n1. Set\n");
+    printf("Set index 2 of a copy to 9, should print:\n");
+    printf("[1, 2, 3, 4]\n");
+    printf("[1, 2, 9, 4]\n");
+    printf("Does print:\n");
+    s = plist_copy(l);
+    plist_set(s, 2, (void *)9);
+    plist_print(l);
+    plist_print(s);
+
+    printf("\n2. Insert, append and pop\n");
+    printf("Insert 7 at 1 and append 5 to the copy, pop index 2 from the original, should print:\n");
+    printf("[1, 2, 4]\n");
+    printf("[0, 7, 1, 2, 3, 4, 5]\n");
+    printf("3\n");
+    printf("Does print:\n");
+    plist_insert(r, 1, (void *)7);
+    plist_append(r, (void *)5);
+    i = (uint64_t)plist_pop(l, 2);
+    plist_print(l);
+    plist_print(r);
+    printf("%lu\n", i);
+
+    printf("\n3. Unchanged snapshot\n");
+    printf("The set copy after all that, should print:\n");
+    printf("[1, 2, 9, 4]\n");
+    printf("4 9\n");
+    printf("Does print:\n");
+    plist_free(l);
+    plist_free(r);
+    m = plist_to_list(s);
+    l = plist_from_list(m);
+    plist_print(l);
+    printf("%lu %lu\n", plist_len(l), (uint64_t)plist_get(l, 2));
+
+    plist_free(l);
+    plist_free(s);
+    list_free(m);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/* queue.c */
+
+#include "queue.h"
+#include <sched.h>
+
+/*
+ A slot is ready for the push at position p when seq == p, and for the
+ pop at position p when seq == p + 1; the pop sets seq to p + cap, the
+ position of the push one lap later.
+ */
+struct queue_slot {
+    _Atomic size_t seq;
+    void *data;
+};
+
+/* Create a queue holding at least cap elements */
+queue_t queue_new(size_t cap) {
+    queue_t q;
+    size_t size = 2, i;
+
+    while (size < cap) {
+        size *= 2;
+    }
+    q = (queue_t)aligned_alloc(64, sizeof(struct queue_struct));
+    if (q == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    q->slots = (struct queue_slot *)malloc(size * sizeof(struct queue_slot));
+    if (q->slots == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    for (i = 0; i < size; i++) {
+        atomic_init(&q->slots[i].seq, i);
+    }
+    q->mask = size - 1;
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+    return q;
+}
+
+/* Free the queue */
+void queue_free(queue_t q) {
+    free(q->slots);
+    free(q);
+}
+
+/* Claim the next push position, or fail if its slot is still full */
+bool queue_push(queue_t q, void *x) {
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed), seq;
+    struct queue_slot *slot;
+
+    for (;;) {
+        slot = &q->slots[pos & q->mask];
+        seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq == pos) {
+            /* On failure pos is reloaded with the current tail */
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if ((intptr_t)(seq - pos) < 0) {
+            /* The pop a lap ago has not freed this slot: full */
+            return FALSE;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+    slot->data = x;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return TRUE;
+}
+
+/* Claim the next pop position, or fail if its slot is not yet filled */
+bool queue_pop(queue_t q, void **out) {
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed), seq;
+    struct queue_slot *slot;
+
+    for (;;) {
+        slot = &q->slots[pos & q->mask];
+        seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq == pos + 1) {
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if ((intptr_t)(seq - (pos + 1)) < 0) {
+            /* No push has filled this slot yet: empty */
+            return FALSE;
+        } else {
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+    *out = slot->data;
+    atomic_store_explicit(&slot->seq, pos + q->mask + 1, memory_order_release);
+    return TRUE;
+}
+
+/* Push, yielding while the queue is full */
+void queue_push_wait(queue_t q, void *x) {
+    while (!queue_push(q, x)) {
+        sched_yield();
+    }
+}
+
+/* Pop, yielding while the queue is empty */
+void *queue_pop_wait(queue_t q) {
+    void *x;
+
+    while (!queue_pop(q, &x)) {
+        sched_yield();
+    }
+    return x;
+}
@@ -0,0 +1,86 @@
+/* queue.h */
+
+/* declares functions in queue.c */
+
+#ifndef QUEUE_T
+#define QUEUE_T
+
+#include <stdatomic.h>
+#include "list_t.h"
+
+/* Notes:
+
+ A queue_t is a bounded FIFO of void * that any number of threads may
+ push to and pop from at once, without a lock (Vyukov's bounded MPMC
+ ring). It replaces the list_append / list_pop(l, 0) hand-off between
+ threads, which needs a mutex around the list_t
+ Each slot carries a sequence number that says whether it is ready to
+ be written or read for the current lap around the ring; a push or pop
+ claims its position with one compare and swap and publishes with one
+ store, and nothing is allocated after queue_new
+ A thread stalled between claiming a slot and publishing it holds up
+ the threads that later reach that slot (but not the others), so this
+ is not strictly lock-free
+ Capacity is rounded up to a power of two
+ */
+
+struct queue_slot;
+
+/* Pushers and poppers each write their own cache line */
+typedef struct queue_struct {
+    struct queue_slot *slots;
+    size_t mask;    /* capacity - 1 */
+    _Atomic size_t tail __attribute__((aligned(64)));    /* next push position */
+    _Atomic size_t head __attribute__((aligned(64)));    /* next pop position */
+} *queue_t;
+
+/*
+ _: New
+ inputs: the number of elements the queue can hold, cap (at least 2)
+ outputs: a new empty queue_t
+ side effects: none
+ */
+queue_t queue_new(size_t cap);
+
+/*
+ _: Free
+ inputs: a queue_t q no thread is still using
+ outputs: nothing
+ side effects: frees all memory associated with q (not the elements)
+ */
+void queue_free(queue_t q);
+
+/*
+ 0: Push
+ inputs: a queue_t q, and a pointer to an memory object of any type x
+ outputs: TRUE if x was added to the back of q, FALSE if q was full
+ side effects: none beyond the push
+ */
+bool queue_push(queue_t q, void *x);
+
+/*
+ 1: Pop
+ inputs: a queue_t q, and where to store the element, out
+ outputs: TRUE if the front element was removed into *out, FALSE if q
+ was empty
+ side effects: none beyond the pop
+ example:
+ queue_t q = queue_new(8);
+ void *x;
+ queue_push(q, (void *)1);
+ queue_pop(q, &x);
+ printf("%lu\n", (uint64_t)x);
+ - should print "1"
+ */
+bool queue_pop(queue_t q, void **out);
+
+/*
+ 2: Waiting push and pop
+ As queue_push and queue_pop, but spin (yielding the CPU) while q is
+ full or empty instead of returning FALSE. For worker pools, push one
+ agreed sentinel per worker to tell them to stop.
+ */
+void queue_push_wait(queue_t q, void *x);
+void *queue_pop_wait(queue_t q);
+
+#endif
@@ -0,0 +1,137 @@
+/* queue_bench.c - queue_t against a list_t behind a mutex */
+
+/*
+ * gcc -O2 queue_bench.c queue.c list_t.c list_vec.c -pthread -o queue_bench
+ *
+ * P producer threads push ITEMS elements between them and C consumer
+ * threads pop them, for P and C in 1, 2, 4 ... MAX_THREADS. When the
+ * producers are done, one 0 per consumer tells it to stop. The baseline
+ * is list_append and list_pop(l, 0) on one list_t behind a mutex, the
+ * way list_t would be shared today; a consumer finding it empty yields.
+ * The queue holds CAP elements. Reports Mops/s (elements through per
+ * second); every element popped is summed, so a lost or duplicated one
+ * shows up as a failed check (-1).
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "queue.h"
+
+#define ITEMS 4000000
+#define CAP 1024
+#define MAX_THREADS 8
+
+typedef struct bench_arg {
+    queue_t q;                  /* NULL for the locked baseline */
+    list_t l;
+    pthread_mutex_t *lock;
+    size_t first, count;        /* producers push first + 1 ... first + count */
+    uint64_t sum;               /* consumers add up what they pop */
+} bench_arg;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void put(bench_arg *a, uint64_t x) {
+    if (a->q != NULL) {
+        queue_push_wait(a->q, (void *)x);
+        return;
+    }
+    pthread_mutex_lock(a->lock);
+    list_append(a->l, (void *)x);
+    pthread_mutex_unlock(a->lock);
+}
+
+static uint64_t take(bench_arg *a) {
+    uint64_t x;
+
+    if (a->q != NULL) {
+        return (uint64_t)queue_pop_wait(a->q);
+    }
+    for (;;) {
+        pthread_mutex_lock(a->lock);
+        if (list_len(a->l) > 0) {
+            x = (uint64_t)list_pop(a->l, 0);
+            pthread_mutex_unlock(a->lock);
+            return x;
+        }
+        pthread_mutex_unlock(a->lock);
+        sched_yield();
+    }
+}
+
+static void *produce(void *p) {
+    bench_arg *a = p;
+    size_t i;
+
+    for (i = 1; i <= a->count; i++) {
+        put(a, a->first + i);
+    }
+    return NULL;
+}
+
+static void *consume(void *p) {
+    bench_arg *a = p;
+    uint64_t x;
+
+    while ((x = take(a)) != 0) {
+        a->sum += x;
+    }
+    return NULL;
+}
+
+/* Run one configuration; returns Mops/s, or -1 if the check failed */
+static double run(int lockfree, size_t np, size_t nc) {
+    pthread_t threads[2 * MAX_THREADS];
+    bench_arg args[2 * MAX_THREADS];
+    pthread_mutex_t lock;
+    queue_t q = queue_new(CAP);
+    list_t l = list_new();
+    uint64_t sum = 0;
+    double start, secs;
+    size_t i, share = ITEMS / np;
+
+    pthread_mutex_init(&lock, NULL);
+    start = now();
+    for (i = 0; i < np + nc; i++) {
+        args[i].q = lockfree ? q : NULL;
+        args[i].l = l;
+        args[i].lock = &lock;
+        args[i].first = i * share;
+        args[i].count = share;
+        args[i].sum = 0;
+        pthread_create(&threads[i], NULL, i < np ? produce : consume, &args[i]);
+    }
+    for (i = 0; i < np; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (i = 0; i < nc; i++) {
+        put(&args[0], 0);
+    }
+    for (i = np; i < np + nc; i++) {
+        pthread_join(threads[i], NULL);
+        sum += args[i].sum;
+    }
+    secs = now() - start;
+
+    queue_free(q);
+    list_free(l);
+    pthread_mutex_destroy(&lock);
+    return sum == (uint64_t)(np * share) * (np * share + 1) / 2 ? (double)(np * share) / secs / 1e6 : -1;
+}
+
+int main(void) {
+    size_t np, nc;
+
+    printf("%10s %10s %12s %12s   (Mops/s)\n", "producers", "consumers", "locked list", "queue_t");
+    for (np = 1; np <= MAX_THREADS; np *= 2) {
+        for (nc = 1; nc <= MAX_THREADS; nc *= 2) {
+            printf("%10lu %10lu %12.2f %12.2f\n", np, nc, run(0, np, nc), run(1, np, nc));
+        }
+    }
+    return 0;
+}
@@ -1,12 +1,8 @@
 #include <stdio.h>
 #include <stdint.h>
 
-/* Bitwise CHOICE macro */
-#define CHOICE(e, f, g) ((e & f) | (~e & g))
-
-/* Bitwise MEDIAN macro */
-#define MEDIAN(e, f, g) ((e & f) | (f & g) | (g & e))
-
-/* Bitwise Right ROTATE macro */
-#define ROTATE(x, n) ((x >> n) | (x << (32 - n)))
-
+/*
+ CHOICE, MEDIAN and ROTATE (a right rotate) now live in macros.h as
+ inline functions, for 32 and 64 bit words and SIMD registers
+ */
+#include "macros.h"
@@ -0,0 +1,186 @@
+/* macros.h */
+
+/*
+ Bit primitives shared by the hash kernels: rotate, choice and median
+ (majority) on 32 and 64 bit words, and on SIMD registers when the
+ target has them. Everything is static inline so constant rotate
+ counts fold into single ror / vprord instructions.
+
+ The scalar forms are type-generic through ROTATE, CHOICE and MEDIAN
+ (uint32_t or uint64_t). CHOICE and MEDIAN also take __m128i, __m256i
+ and __m512i, where they are the same bitwise function of every bit;
+ vector rotates depend on the lane width and are called by name, e.g.
+ rotr32_256.
+ */
+
+#ifndef MACROS_H
+#define MACROS_H
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/* Right and left rotates; n is taken mod the word size */
+static inline uint32_t rotr32(uint32_t x, unsigned n) {
+    return (x >> (n & 31)) | (x << (-n & 31));
+}
+
+static inline uint64_t rotr64(uint64_t x, unsigned n) {
+    return (x >> (n & 63)) | (x << (-n & 63));
+}
+
+static inline uint32_t rotl32(uint32_t x, unsigned n) {
+    return (x << (n & 31)) | (x >> (-n & 31));
+}
+
+static inline uint64_t rotl64(uint64_t x, unsigned n) {
+    return (x << (n & 63)) | (x >> (-n & 63));
+}
+
+/* Each bit of f where e is set, else of g */
+static inline uint32_t choice32(uint32_t e, uint32_t f, uint32_t g) {
+    return g ^ (e & (f ^ g));
+}
+
+static inline uint64_t choice64(uint64_t e, uint64_t f, uint64_t g) {
+    return g ^ (e & (f ^ g));
+}
+
+/* Each bit set in at least two of e, f and g */
+static inline uint32_t median32(uint32_t e, uint32_t f, uint32_t g) {
+    return (e & f) | (g & (e | f));
+}
+
+static inline uint64_t median64(uint64_t e, uint64_t f, uint64_t g) {
+    return (e & f) | (g & (e | f));
+}
+
+/*
+ SSE2: 4 x 32 or 2 x 64 bit lanes. With AVX-512VL the rotates are one
+ vprord / vprorq and choice / median one vpternlogd; otherwise shifts
+ and logic ops.
+ ternarylogic immediates: 0xca is e ? f : g, 0xe8 is majority.
+ */
+#ifdef __SSE2__
+
+static inline __m128i choice_128(__m128i e, __m128i f, __m128i g) {
+#ifdef __AVX512VL__
+    return _mm_ternarylogic_epi32(e, f, g, 0xca);
+#else
+    return _mm_xor_si128(g, _mm_and_si128(e, _mm_xor_si128(f, g)));
+#endif
+}
+
+static inline __m128i median_128(__m128i e, __m128i f, __m128i g) {
+#ifdef __AVX512VL__
+    return _mm_ternarylogic_epi32(e, f, g, 0xe8);
+#else
+    return _mm_or_si128(_mm_and_si128(e, f), _mm_and_si128(g, _mm_or_si128(e, f)));
+#endif
+}
+
+/* The AVX-512VL rotates take an immediate, so n must be a constant there */
+#ifdef __AVX512VL__
+#define rotr32_128(x, n) _mm_ror_epi32((x), (n))
+#define rotr64_128(x, n) _mm_ror_epi64((x), (n))
+#else
+static inline __m128i rotr32_128(__m128i x, unsigned n) {
+    return _mm_or_si128(_mm_srli_epi32(x, n & 31), _mm_slli_epi32(x, -n & 31));
+}
+
+static inline __m128i rotr64_128(__m128i x, unsigned n) {
+    return _mm_or_si128(_mm_srli_epi64(x, n & 63), _mm_slli_epi64(x, -n & 63));
+}
+#endif
+
+#endif /* __SSE2__ */
+
+/* AVX2: 8 x 32 or 4 x 64 bit lanes */
+#ifdef __AVX2__
+
+static inline __m256i choice_256(__m256i e, __m256i f, __m256i g) {
+#ifdef __AVX512VL__
+    return _mm256_ternarylogic_epi32(e, f, g, 0xca);
+#else
+    return _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+#endif
+}
+
+static inline __m256i median_256(__m256i e, __m256i f, __m256i g) {
+#ifdef __AVX512VL__
+    return _mm256_ternarylogic_epi32(e, f, g, 0xe8);
+#else
+    return _mm256_or_si256(_mm256_and_si256(e, f), _mm256_and_si256(g, _mm256_or_si256(e, f)));
+#endif
+}
+
+#ifdef __AVX512VL__
+#define rotr32_256(x, n) _mm256_ror_epi32((x), (n))
+#define rotr64_256(x, n) _mm256_ror_epi64((x), (n))
+#else
+static inline __m256i rotr32_256(__m256i x, unsigned n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n & 31), _mm256_slli_epi32(x, -n & 31));
+}
+
+static inline __m256i rotr64_256(__m256i x, unsigned n) {
+    return _mm256_or_si256(_mm256_srli_epi64(x, n & 63), _mm256_slli_epi64(x, -n & 63));
+}
+#endif
+
+#endif /* __AVX2__ */
+
+/* AVX-512F: 16 x 32 or 8 x 64 bit lanes, always ternarylogic */
+#ifdef __AVX512F__
+
+static inline __m512i choice_512(__m512i e, __m512i f, __m512i g) {
+    return _mm512_ternarylogic_epi32(e, f, g, 0xca);
+}
+
+static inline __m512i median_512(__m512i e, __m512i f, __m512i g) {
+    return _mm512_ternarylogic_epi32(e, f, g, 0xe8);
+}
+
+#define rotr32_512(x, n) _mm512_ror_epi32((x), (n))
+#define rotr64_512(x, n) _mm512_ror_epi64((x), (n))
+
+#endif /* __AVX512F__ */
+
+/*
+ Type-generic names, kept from macros.c. Anything but uint32_t and
+ uint64_t (or a vector, for CHOICE and MEDIAN) fails to compile rather
+ than picking a width.
+ */
+
+#ifdef __SSE2__
+#define MACROS_CHOICE_128 , __m128i: choice_128
+#define MACROS_MEDIAN_128 , __m128i: median_128
+#else
+#define MACROS_CHOICE_128
+#define MACROS_MEDIAN_128
+#endif
+
+#ifdef __AVX2__
+#define MACROS_CHOICE_256 , __m256i: choice_256
+#define MACROS_MEDIAN_256 , __m256i: median_256
+#else
+#define MACROS_CHOICE_256
+#define MACROS_MEDIAN_256
+#endif
+
+#ifdef __AVX512F__
+#define MACROS_CHOICE_512 , __m512i: choice_512
+#define MACROS_MEDIAN_512 , __m512i: median_512
+#else
+#define MACROS_CHOICE_512
+#define MACROS_MEDIAN_512
+#endif
+
+#define ROTATE(x, n) _Generic((x), uint32_t: rotr32, uint64_t: rotr64)((x), (n))
+#define CHOICE(e, f, g) _Generic((e), uint32_t: choice32, uint64_t: choice64 \
+    MACROS_CHOICE_128 MACROS_CHOICE_256 MACROS_CHOICE_512)((e), (f), (g))
+#define MEDIAN(e, f, g) _Generic((e), uint32_t: median32, uint64_t: median64 \
+    MACROS_MEDIAN_128 MACROS_MEDIAN_256 MACROS_MEDIAN_512)((e), (f), (g))
+
+#endif /* MACROS_H */
@@ -0,0 +1,169 @@
+/* tester.c */
+
+/* tests macros.h against the plain shift and logic formulas */
+
+/*
+ * gcc tester.c -o tester
+ * gcc -mavx2 tester.c -o tester
+ * gcc -mavx512f -mavx512vl tester.c -o tester
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "macros.h"
+
+#define ROUNDS 100000
+
+/* The formulas macros.c and shainc.c used, parenthesized */
+#define REF_CHOICE(e, f, g) (((e) & (f)) | (~(e) & (g)))
+#define REF_MEDIAN(e, f, g) (((e) & (f)) ^ ((e) & (g)) ^ ((f) & (g)))
+#define REF_ROTR(x, n, w) (((x) >> (n)) | ((x) << ((w) - (n))))
+
+static uint64_t seed = 88172645463325252ULL;
+
+static uint64_t rnd(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+/* Lanes of 64 bytes of x, e, f, g as 32 or 64 bit words */
+typedef union lanes {
+    uint32_t w32[16];
+    uint64_t w64[8];
+} lanes;
+
+/* Check vector results r32 (rotr32 by 7), r64 (rotr64 by 41), c, m over bytes */
+static int check_lanes(lanes *x, lanes *e, lanes *f, lanes *g, lanes *r32, lanes *r64,
+                       lanes *c, lanes *m, size_t bytes) {
+    size_t i;
+
+    for (i = 0; i < bytes / 4; i++) {
+        if (r32->w32[i] != rotr32(x->w32[i], 7)) {
+            return 0;
+        }
+    }
+    for (i = 0; i < bytes / 8; i++) {
+        if (r64->w64[i] != rotr64(x->w64[i], 41)
+            || c->w64[i] != choice64(e->w64[i], f->w64[i], g->w64[i])
+            || m->w64[i] != median64(e->w64[i], f->w64[i], g->w64[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main()
+{
+    uint64_t x, e, f, g;
+    uint32_t x32, e32, f32, g32;
+    lanes lx, le, lf, lg, r32, r64, c, m;
+    unsigned n;
+    int i, j, ok;
+
+    /* Test scalar rotates */
+
+    printf("\n0. Rotate\n");
+    printf("32 and 64 bit rotates by 1..w-1 against shifts, should print:\n");
+    printf("1\n");
+    printf("Does print:\n");
+    ok = 1;
+    for (i = 0; i < ROUNDS; i++) {
+        x = rnd();
+        x32 = (uint32_t)x;
+        n = (unsigned)(i % 31) + 1;
+        ok &= ROTATE(x32, n) == (uint32_t)REF_ROTR(x32, n, 32)
+              && rotl32(x32, 32 - n) == ROTATE(x32, n);
+        n = (unsigned)(i % 63) + 1;
+        ok &= ROTATE(x, n) == REF_ROTR(x, n, 64) && rotl64(x, 64 - n) == ROTATE(x, n);
+    }
+    ok &= rotr32(0x80000001u, 0) == 0x80000001u && rotr64(1, 64) == 1;
+    printf("%d\n", ok);
+
+    /* Test scalar choice and median */
+
+    printf("\n1. Choice and median\n");
+    printf("32 and 64 bit CHOICE and MEDIAN against the old formulas, should print:\n");
+    printf("1\n");
+    printf("Does print:\n");
+    ok = 1;
+    for (i = 0; i < ROUNDS; i++) {
+        e = rnd(); f = rnd(); g = rnd();
+        e32 = (uint32_t)e; f32 = (uint32_t)f; g32 = (uint32_t)g;
+        ok &= CHOICE(e, f, g) == REF_CHOICE(e, f, g) && MEDIAN(e, f, g) == REF_MEDIAN(e, f, g);
+        ok &= CHOICE(e32, f32, g32) == (uint32_t)REF_CHOICE(e32, f32, g32)
+              && MEDIAN(e32, f32, g32) == (uint32_t)REF_MEDIAN(e32, f32, g32);
+    }
+    printf("%d\n", ok);
+
+    /* Test vector forms lane by lane against the scalar ones */
+
+    printf("\n2. Vectors\n");
+    printf("Each vector width built in, lane by lane against scalar, should print:\n");
+    printf("1\n");
+    printf("Does print:\n");
+    ok = 1;
+    for (i = 0; i < ROUNDS / 100; i++) {
+        for (j = 0; j < 8; j++) {
+            lx.w64[j] = rnd(); le.w64[j] = rnd(); lf.w64[j] = rnd(); lg.w64[j] = rnd();
+        }
+#ifdef __SSE2__
+        {
+            __m128i vx = _mm_loadu_si128((__m128i *)&lx), ve = _mm_loadu_si128((__m128i *)&le),
+                    vf = _mm_loadu_si128((__m128i *)&lf), vg = _mm_loadu_si128((__m128i *)&lg);
+            _mm_storeu_si128((__m128i *)&r32, rotr32_128(vx, 7));
+            _mm_storeu_si128((__m128i *)&r64, rotr64_128(vx, 41));
+            _mm_storeu_si128((__m128i *)&c, CHOICE(ve, vf, vg));
+            _mm_storeu_si128((__m128i *)&m, MEDIAN(ve, vf, vg));
+            ok &= check_lanes(&lx, &le, &lf, &lg, &r32, &r64, &c, &m, 16);
+        }
+#endif
+#ifdef __AVX2__
+        {
+            __m256i vx = _mm256_loadu_si256((__m256i *)&lx), ve = _mm256_loadu_si256((__m256i *)&le),
+                    vf = _mm256_loadu_si256((__m256i *)&lf), vg = _mm256_loadu_si256((__m256i *)&lg);
+            _mm256_storeu_si256((__m256i *)&r32, rotr32_256(vx, 7));
+            _mm256_storeu_si256((__m256i *)&r64, rotr64_256(vx, 41));
+            _mm256_storeu_si256((__m256i *)&c, CHOICE(ve, vf, vg));
+            _mm256_storeu_si256((__m256i *)&m, MEDIAN(ve, vf, vg));
+            ok &= check_lanes(&lx, &le, &lf, &lg, &r32, &r64, &c, &m, 32);
+        }
+#endif
+#ifdef __AVX512F__
+        {
+            __m512i vx = _mm512_loadu_si512(&lx), ve = _mm512_loadu_si512(&le),
+                    vf = _mm512_loadu_si512(&lf), vg = _mm512_loadu_si512(&lg);
+            _mm512_storeu_si512(&r32, rotr32_512(vx, 7));
+            _mm512_storeu_si512(&r64, rotr64_512(vx, 41));
+            _mm512_storeu_si512(&c, CHOICE(ve, vf, vg));
+            _mm512_storeu_si512(&m, MEDIAN(ve, vf, vg));
+            ok &= check_lanes(&lx, &le, &lf, &lg, &r32, &r64, &c, &m, 64);
+        }
+#endif
+    }
+    printf("%d\n", ok);
+    printf("(built with:%s%s%s%s)\n",
+#ifdef __SSE2__
+           " SSE2",
+#else
+           "",
+#endif
+#ifdef __AVX2__
+           " AVX2",
+#else
+           "",
+#endif
+#ifdef __AVX512F__
+           " AVX-512F",
+#else
+           "",
+#endif
+#ifdef __AVX512VL__
+           " AVX-512VL"
+#else
+           ""
+#endif
+           );
+    return 0;
+}
@@ -0,0 +1,136 @@
+/* bench.c - MB/s of SHA-256 against the SHA-512 family */
+
+/*
+ * gcc -O2 -march=native bench.c sha.c -o bench
+ *
+ * First checks every algorithm on the FIPS 180 "abc" and two block
+ * messages, one shot and fed through update in odd sized pieces. Then
+ * hashes TOTAL bytes as messages of each size in SIZES, one shot, and
+ * reports MB/s; small messages show the cost of padding and the final
+ * block, 128 bytes for the SHA-512 family against 64 for SHA-256.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sha.h"
+
+#define TOTAL (1 << 28)
+
+static const size_t SIZES[] = {64, 1024, 16384, 1 << 20};
+
+typedef struct algorithm {
+    const char *name;
+    void (*one_shot)(const uint8_t *, uint64_t, uint8_t *);
+    void (*init)(sha512_ctx *);     /* NULL for SHA-256 */
+    size_t digest;
+    const char *abc, *two_block;    /* expected hex digests */
+} algorithm;
+
+static const algorithm ALGS[] = {
+    {"SHA-256", sha256, NULL, SHA256_DIGEST,
+     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+     "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {"SHA-384", sha384, sha384_init, SHA384_DIGEST,
+     "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+     "8086072ba1e7cc2358baeca134c825a7",
+     "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+     "fcc7c71a557e2db966c3e9fa91746039"},
+    {"SHA-512", sha512, sha512_init, SHA512_DIGEST,
+     "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+     "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+     "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+     "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909"},
+    {"SHA-512/256", sha512_256, sha512_256_init, SHA512_256_DIGEST,
+     "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23",
+     "3928e184fb8690f840da3988121d31be65cb9d3ef83ee6146feac861e19b563a"},
+};
+
+#define NALGS (sizeof(ALGS) / sizeof(ALGS[0]))
+#define NSIZES (sizeof(SIZES) / sizeof(SIZES[0]))
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Digest matches the expected hex */
+static int matches(const uint8_t *digest, size_t len, const char *hex) {
+    char text[2 * SHA512_DIGEST + 1];
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        sprintf(text + 2 * i, "%02x", digest[i]);
+    }
+    return !strcmp(text, hex);
+}
+
+/* One shot and streamed (pieces of 1, 2, 3 ... bytes) digests of msg */
+static int check(const algorithm *a, const char *msg, const char *hex) {
+    const uint8_t *p = (const uint8_t *)msg;
+    size_t len = strlen(msg), off, piece;
+    uint8_t digest[SHA512_DIGEST];
+    sha256_ctx c256;
+    sha512_ctx c512;
+    int ok;
+
+    a->one_shot(p, len, digest);
+    ok = matches(digest, a->digest, hex);
+    if (a->init) {
+        a->init(&c512);
+    } else {
+        sha256_init(&c256);
+    }
+    for (off = 0, piece = 1; off < len; off += piece, piece++) {
+        piece = piece < len - off ? piece : len - off;
+        if (a->init) {
+            sha512_update(&c512, p + off, piece);
+        } else {
+            sha256_update(&c256, p + off, piece);
+        }
+    }
+    if (a->init) {
+        sha512_final(&c512, digest);
+    } else {
+        sha256_final(&c256, digest);
+    }
+    return ok && matches(digest, a->digest, hex);
+}
+
+int main(void) {
+    const char *two_block = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                            "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    uint8_t *buf = malloc(TOTAL), digest[SHA512_DIGEST];
+    size_t a, s, off;
+    double start;
+
+    if (buf == NULL) {
+        fprintf(stderr, "Failed to allocate memory for bench\n");
+        return 1;
+    }
+    for (off = 0; off < TOTAL; off++) {
+        buf[off] = (uint8_t)(off * 0x9e3779b1u >> 24);
+    }
+
+    printf("%-12s", "");
+    for (s = 0; s < NSIZES; s++) {
+        printf(" %9lu B", SIZES[s]);
+    }
+    printf("   (MB/s)\n");
+    for (a = 0; a < NALGS; a++) {
+        int ok = check(&ALGS[a], "abc", ALGS[a].abc) && check(&ALGS[a], two_block, ALGS[a].two_block);
+        printf("%-12s", ALGS[a].name);
+        for (s = 0; s < NSIZES; s++) {
+            start = now();
+            for (off = 0; off + SIZES[s] <= TOTAL; off += SIZES[s]) {
+                ALGS[a].one_shot(buf + off, SIZES[s], digest);
+            }
+            printf(" %11.1f", TOTAL / (now() - start) / 1e6);
+        }
+        printf("  %s\n", ok ? "ok" : "MISMATCH");
+    }
+    free(buf);
+    return 0;
+}
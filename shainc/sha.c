@@ -0,0 +1,329 @@
+/* sha.c */
+
+/* SHA-256 and the SHA-512 family (sha.h) on the macros.h bit primitives */
+
+#include <string.h>
+#include "sha.h"
+#include "../macros/macros.h"
+
+/* SHA-256 Constants */
+static const uint32_t k256[64] = {
+    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,
+    0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+    0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,
+    0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+    0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,
+    0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+    0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,
+    0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+    0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,
+    0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+    0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,
+    0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+    0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,
+    0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+    0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,
+    0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+};
+
+/* SHA-256 initial hash values */
+static const uint32_t iv256[8] = {
+    0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,
+    0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
+/* SHA-512 Constants */
+static const uint64_t k512[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+/* Initial hash values for SHA-512, SHA-384 and SHA-512/256 */
+static const uint64_t iv512[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static const uint64_t iv384[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+
+static const uint64_t iv512_256[8] = {
+    0x22312194fc2bf72cULL, 0x9f555fa3c84c64c2ULL, 0x2393b86b6f53b151ULL, 0x963877195940eabdULL,
+    0x96283ee2a88effe3ULL, 0xbe5e1e2553863992ULL, 0x2b0199fc2c85b8aaULL, 0x0eb72ddc81c52ca2ULL
+};
+
+/* SHA-256 functions of words (ROTATE, CHOICE, MEDIAN: macros.h) */
+#define SIGMA0_256(x) (ROTATE(x,2) ^ ROTATE(x,13) ^ ROTATE(x,22))
+#define SIGMA1_256(x) (ROTATE(x,6) ^ ROTATE(x,11) ^ ROTATE(x,25))
+#define sigma0_256(x) (ROTATE(x,7) ^ ROTATE(x,18) ^ ((x) >> 3))
+#define sigma1_256(x) (ROTATE(x,17) ^ ROTATE(x,19) ^ ((x) >> 10))
+
+/* The same on 64 bit words */
+#define SIGMA0_512(x) (ROTATE(x,28) ^ ROTATE(x,34) ^ ROTATE(x,39))
+#define SIGMA1_512(x) (ROTATE(x,14) ^ ROTATE(x,18) ^ ROTATE(x,41))
+#define sigma0_512(x) (ROTATE(x,1) ^ ROTATE(x,8) ^ ((x) >> 7))
+#define sigma1_512(x) (ROTATE(x,19) ^ ROTATE(x,61) ^ ((x) >> 6))
+
+/*
+ Both compressions keep the schedule in a 16 word ring, w[i & 15], and
+ rename a..h by rotating macro arguments instead of moving them each
+ round; one ROUNDS8 is eight rounds, after which the names are back in
+ place. NEXT computes the schedule word for round i >= 16 in place.
+ */
+#define NEXT(w, i, s0, s1) (w[(i) & 15] += s1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + s0(w[((i) - 15) & 15]))
+
+#define ROUND(a, b, c, d, e, f, g, h, k, wi, S0, S1) do { \
+        t = h + S1(e) + CHOICE(e, f, g) + (k) + (wi); \
+        d += t; \
+        h = t + S0(a) + MEDIAN(a, b, c); \
+    } while (0)
+
+#define ROUNDS8(R, i) do { \
+        R(a, b, c, d, e, f, g, h, (i)); \
+        R(h, a, b, c, d, e, f, g, (i) + 1); \
+        R(g, h, a, b, c, d, e, f, (i) + 2); \
+        R(f, g, h, a, b, c, d, e, (i) + 3); \
+        R(e, f, g, h, a, b, c, d, (i) + 4); \
+        R(d, e, f, g, h, a, b, c, (i) + 5); \
+        R(c, d, e, f, g, h, a, b, (i) + 6); \
+        R(b, c, d, e, f, g, h, a, (i) + 7); \
+    } while (0)
+
+/* Rounds with the first 16 (loaded) schedule words, then computed ones */
+#define R256(a, b, c, d, e, f, g, h, i) ROUND(a, b, c, d, e, f, g, h, k256[i], w[i], SIGMA0_256, SIGMA1_256)
+#define R256N(a, b, c, d, e, f, g, h, i) \
+    ROUND(a, b, c, d, e, f, g, h, k256[i], NEXT(w, i, sigma0_256, sigma1_256), SIGMA0_256, SIGMA1_256)
+#define R512(a, b, c, d, e, f, g, h, i) ROUND(a, b, c, d, e, f, g, h, k512[i], w[i], SIGMA0_512, SIGMA1_512)
+#define R512N(a, b, c, d, e, f, g, h, i) \
+    ROUND(a, b, c, d, e, f, g, h, k512[i], NEXT(w, i, sigma0_512, sigma1_512), SIGMA0_512, SIGMA1_512)
+
+/* Big-endian loads and stores */
+static uint32_t load32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint64_t load64(const uint8_t *p) {
+    return ((uint64_t)load32(p) << 32) | load32(p + 4);
+}
+
+static void store64(uint8_t *p, uint64_t x) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(x >> (56 - 8 * i));
+    }
+}
+
+/* Compress n 64 byte blocks into hash */
+static void sha256_blocks(uint32_t *hash, const uint8_t *p, size_t n) {
+    uint32_t w[16], a, b, c, d, e, f, g, h, t;
+    int i;
+
+    for (; n > 0; n--, p += 64) {
+        for (i = 0; i < 16; i++) {
+            w[i] = load32(p + 4 * i);
+        }
+        a = hash[0]; b = hash[1]; c = hash[2]; d = hash[3];
+        e = hash[4]; f = hash[5]; g = hash[6]; h = hash[7];
+        ROUNDS8(R256, 0);
+        ROUNDS8(R256, 8);
+        for (i = 16; i < 64; i += 8) {
+            ROUNDS8(R256N, i);
+        }
+        hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+        hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+    }
+}
+
+/* Compress n 128 byte blocks into hash */
+static void sha512_blocks(uint64_t *hash, const uint8_t *p, size_t n) {
+    uint64_t w[16], a, b, c, d, e, f, g, h, t;
+    int i;
+
+    for (; n > 0; n--, p += 128) {
+        for (i = 0; i < 16; i++) {
+            w[i] = load64(p + 8 * i);
+        }
+        a = hash[0]; b = hash[1]; c = hash[2]; d = hash[3];
+        e = hash[4]; f = hash[5]; g = hash[6]; h = hash[7];
+        ROUNDS8(R512, 0);
+        ROUNDS8(R512, 8);
+        for (i = 16; i < 80; i += 8) {
+            ROUNDS8(R512N, i);
+        }
+        hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+        hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+    }
+}
+
+void sha256_init(sha256_ctx *ctx) {
+    memcpy(ctx->h, iv256, sizeof(iv256));
+    ctx->len = 0;
+    ctx->used = 0;
+}
+
+void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len) {
+    size_t take;
+
+    if (len == 0) {
+        return;
+    }
+    ctx->len += len;
+
+    /* Top up a partial block first */
+    if (ctx->used > 0) {
+        take = len < 64 - ctx->used ? len : 64 - ctx->used;
+        memcpy(ctx->buf + ctx->used, data, take);
+        ctx->used += take;
+        data += take;
+        len -= take;
+        if (ctx->used < 64) {
+            return;
+        }
+        sha256_blocks(ctx->h, ctx->buf, 1);
+        ctx->used = 0;
+    }
+
+    /* Whole blocks straight from data, the rest into buf */
+    sha256_blocks(ctx->h, data, len / 64);
+    ctx->used = len % 64;
+    memcpy(ctx->buf, data + len - ctx->used, ctx->used);
+}
+
+/* Pad with 0x80, zeros and the bit length to a block boundary */
+void sha256_final(sha256_ctx *ctx, uint8_t *digest) {
+    uint64_t bits = ctx->len * 8;
+    int i;
+
+    ctx->buf[ctx->used++] = 0x80;
+    if (ctx->used > 56) {
+        memset(ctx->buf + ctx->used, 0, 64 - ctx->used);
+        sha256_blocks(ctx->h, ctx->buf, 1);
+        ctx->used = 0;
+    }
+    memset(ctx->buf + ctx->used, 0, 56 - ctx->used);
+    store64(ctx->buf + 56, bits);
+    sha256_blocks(ctx->h, ctx->buf, 1);
+    for (i = 0; i < 8; i++) {
+        digest[i * 4] = (ctx->h[i] >> 24) & 0xFF;
+        digest[i * 4 + 1] = (ctx->h[i] >> 16) & 0xFF;
+        digest[i * 4 + 2] = (ctx->h[i] >> 8) & 0xFF;
+        digest[i * 4 + 3] = ctx->h[i] & 0xFF;
+    }
+}
+
+/* Start with the given initial values and digest length */
+static void sha512_start(sha512_ctx *ctx, const uint64_t *iv, size_t out_len) {
+    memcpy(ctx->h, iv, 8 * sizeof(uint64_t));
+    ctx->len = 0;
+    ctx->used = 0;
+    ctx->out_len = out_len;
+}
+
+void sha512_init(sha512_ctx *ctx) {
+    sha512_start(ctx, iv512, SHA512_DIGEST);
+}
+
+void sha384_init(sha512_ctx *ctx) {
+    sha512_start(ctx, iv384, SHA384_DIGEST);
+}
+
+void sha512_256_init(sha512_ctx *ctx) {
+    sha512_start(ctx, iv512_256, SHA512_256_DIGEST);
+}
+
+void sha512_update(sha512_ctx *ctx, const uint8_t *data, size_t len) {
+    size_t take;
+
+    if (len == 0) {
+        return;
+    }
+    ctx->len += len;
+
+    /* Top up a partial block first */
+    if (ctx->used > 0) {
+        take = len < 128 - ctx->used ? len : 128 - ctx->used;
+        memcpy(ctx->buf + ctx->used, data, take);
+        ctx->used += take;
+        data += take;
+        len -= take;
+        if (ctx->used < 128) {
+            return;
+        }
+        sha512_blocks(ctx->h, ctx->buf, 1);
+        ctx->used = 0;
+    }
+
+    /* Whole blocks straight from data, the rest into buf */
+    sha512_blocks(ctx->h, data, len / 128);
+    ctx->used = len % 128;
+    memcpy(ctx->buf, data + len - ctx->used, ctx->used);
+}
+
+/* As sha256_final, with a 128 bit length (the top 64 bits from len) */
+void sha512_final(sha512_ctx *ctx, uint8_t *digest) {
+    uint8_t full[SHA512_DIGEST];
+    int i;
+
+    ctx->buf[ctx->used++] = 0x80;
+    if (ctx->used > 112) {
+        memset(ctx->buf + ctx->used, 0, 128 - ctx->used);
+        sha512_blocks(ctx->h, ctx->buf, 1);
+        ctx->used = 0;
+    }
+    memset(ctx->buf + ctx->used, 0, 112 - ctx->used);
+    store64(ctx->buf + 112, ctx->len >> 61);
+    store64(ctx->buf + 120, ctx->len << 3);
+    sha512_blocks(ctx->h, ctx->buf, 1);
+    for (i = 0; i < 8; i++) {
+        store64(full + 8 * i, ctx->h[i]);
+    }
+    memcpy(digest, full, ctx->out_len);
+}
+
+void sha256(const uint8_t *message, uint64_t length, uint8_t *hash) {
+    sha256_ctx ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, message, length);
+    sha256_final(&ctx, hash);
+}
+
+void sha512(const uint8_t *message, uint64_t length, uint8_t *hash) {
+    sha512_ctx ctx;
+    sha512_init(&ctx);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, hash);
+}
+
+void sha384(const uint8_t *message, uint64_t length, uint8_t *hash) {
+    sha512_ctx ctx;
+    sha384_init(&ctx);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, hash);
+}
+
+void sha512_256(const uint8_t *message, uint64_t length, uint8_t *hash) {
+    sha512_ctx ctx;
+    sha512_256_init(&ctx);
+    sha512_update(&ctx, message, length);
+    sha512_final(&ctx, hash);
+}
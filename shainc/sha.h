@@ -0,0 +1,59 @@
+/* sha.h */
+
+/* SHA-256 and SHA-512 / SHA-384 / SHA-512/256, one shot or streaming */
+
+#ifndef SHA_H
+#define SHA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ Streaming use: init, then update with the message in pieces of any
+ size, then final writes the digest. A context may be reused after
+ final by calling init again. Digests are big-endian bytes, as printed.
+
+ SHA-512 works on 64 bit words and 128 byte blocks, so on 64 bit hosts
+ without SHA instructions it hashes large inputs faster per byte than
+ SHA-256. SHA-384 and SHA-512/256 are SHA-512 with other initial values,
+ cut to 48 and 32 bytes.
+ */
+
+#define SHA256_DIGEST 32
+#define SHA384_DIGEST 48
+#define SHA512_DIGEST 64
+#define SHA512_256_DIGEST 32
+
+typedef struct sha256_ctx {
+    uint32_t h[8];
+    uint64_t len;       /* bytes so far */
+    uint8_t buf[64];    /* partial block */
+    size_t used;        /* bytes in buf */
+} sha256_ctx;
+
+typedef struct sha512_ctx {
+    uint64_t h[8];
+    uint64_t len;       /* bytes so far */
+    uint8_t buf[128];   /* partial block */
+    size_t used;        /* bytes in buf */
+    size_t out_len;     /* digest bytes final writes */
+} sha512_ctx;
+
+void sha256_init(sha256_ctx *ctx);
+void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len);
+void sha256_final(sha256_ctx *ctx, uint8_t *digest);
+
+/* sha512_update and sha512_final serve all three */
+void sha512_init(sha512_ctx *ctx);
+void sha384_init(sha512_ctx *ctx);
+void sha512_256_init(sha512_ctx *ctx);
+void sha512_update(sha512_ctx *ctx, const uint8_t *data, size_t len);
+void sha512_final(sha512_ctx *ctx, uint8_t *digest);
+
+/* One shot: digest of length bytes of message */
+void sha256(const uint8_t *message, uint64_t length, uint8_t *hash);
+void sha512(const uint8_t *message, uint64_t length, uint8_t *hash);
+void sha384(const uint8_t *message, uint64_t length, uint8_t *hash);
+void sha512_256(const uint8_t *message, uint64_t length, uint8_t *hash);
+
+#endif /* SHA_H */